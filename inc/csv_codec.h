@@ -0,0 +1,65 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef CSV_CODEC_H
+#define CSV_CODEC_H
+
+// EXTERNAL INCLUDES
+#include <memory>
+#include <stddef.h>
+#include <stdio.h>
+// INTERNAL INCLUDES
+#include "types.h"
+
+#define CSV_WRITE_BUFFER (1024 * 1024)
+
+//********************************************************************************************
+// RFC 4180 output. Rows are collected in a large buffer and written in few big chunks,
+// fields are only quoted when they contain a separator, a quote or a line break.
+typedef struct csv_writer_t
+{
+    FILE* file = NULL;
+    std::unique_ptr<char[]> buffer;
+    size_t used = 0;
+    bool failed = false;
+} csv_writer_t;
+//********************************************************************************************
+bool csv_writer_open(csv_writer_t& writer, const char* filename);
+bool csv_writer_close(csv_writer_t& writer); // false when any write failed
+void csv_writer_flush(csv_writer_t& writer);
+void csv_write_raw(csv_writer_t& writer, const char* data, size_t length);
+void csv_write_field(csv_writer_t& writer, const char* data, size_t length);
+void csv_write_u64(csv_writer_t& writer, u64 value);
+// Nanosecond timestamp as "seconds.fraction" with all nine fraction digits
+void csv_write_timestamp(csv_writer_t& writer, u64 timestamp);
+void csv_end_row(csv_writer_t& writer);
+// Collapses doubled quotes of a quoted field body, dst may equal src
+u32 csv_unescape(char* dst, const char* src, size_t length);
+//********************************************************************************************
+inline void csv_write_separator(csv_writer_t& writer)
+{
+    if (writer.used == CSV_WRITE_BUFFER)
+        csv_writer_flush(writer);
+    writer.buffer[writer.used++] = ',';
+}
+//********************************************************************************************
+
+#endif // CSV_CODEC_H
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+#ifndef DEBUG_ALLOC_H
+#define DEBUG_ALLOC_H
+
+// INTERNAL INCLUDES
+#include "types.h"
+
+// Counts heap allocations per thread so hot paths can assert they make none. Only on in
+// builds against the debug CRT, define DEBUG_ALLOC_COUNT to 0 or 1 to override.
+#if !defined(DEBUG_ALLOC_COUNT)
+#if defined(_DEBUG)
+#define DEBUG_ALLOC_COUNT 1
+#else
+#define DEBUG_ALLOC_COUNT 0
+#endif
+#endif
+
+//********************************************************************************************
+#if DEBUG_ALLOC_COUNT
+// Heap allocations made by the calling thread so far
+u64 debug_alloc_count(void);
+#endif
+//********************************************************************************************
+
+#endif // DEBUG_ALLOC_H
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef FUZZY_MATCH_H
+#define FUZZY_MATCH_H
+
+// EXTERNAL INCLUDES
+#include <stddef.h>
+// INTERNAL INCLUDES
+#include "types.h"
+
+// Longest pattern the bit-parallel search handles, longer ones are cut
+#define FUZZY_MAX_LENGTH 64
+// Most edits a fuzzy match may take
+#define FUZZY_MAX_EDITS 3
+
+//********************************************************************************************
+// Pattern prepared for approximate search with Bitap (Wu-Manber): one bit per pattern
+// position holds whether the prefix up to it matches the text so far with d edits, for
+// every d up to max_edits. Each text byte then costs a few shifts and ands per d.
+typedef struct fuzzy_pattern_t
+{
+    u64 masks[256];     // positions of every byte value in the pattern
+    u32 length;
+    u32 max_edits;
+} fuzzy_pattern_t;
+//********************************************************************************************
+void fuzzy_pattern_init(fuzzy_pattern_t& pattern, const char* text, size_t length, u32 max_edits, bool ignore_case);
+// True when text contains the pattern with at most max_edits insertions, deletions or
+// substitutions
+bool fuzzy_find(const fuzzy_pattern_t& pattern, const char* text, size_t length);
+//********************************************************************************************
+
+#endif // FUZZY_MATCH_H
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef LOG_BITMAP_H
+#define LOG_BITMAP_H
+
+// EXTERNAL INCLUDES
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+// INTERNAL INCLUDES
+#include "types.h"
+
+// Words of a dense bitmap, one bit for each of the 65536 rows of a segment
+#define LOG_BITMAP_WORDS 1024
+// Rows kept as a sorted array before the bitmap switches to its dense form
+#define LOG_BITMAP_ARRAY_MAX 4096
+
+//********************************************************************************************
+// Rows of one segment with a given severity or origin, stored like a roaring container:
+// a sorted array of row indices while sparse and a plain bitmap once dense.
+typedef struct log_bitmap_t
+{
+    std::vector<u16> rows;      // sparse form
+    std::vector<u64> words;     // dense form, empty while rows is used
+    u32 cardinality = 0;
+} log_bitmap_t;
+//********************************************************************************************
+// Row bitmaps of a segment keyed by a small value such as a severity or an origin id,
+// only values that occur in the segment get a bitmap
+typedef struct log_bitmap_set_t
+{
+    std::vector<u32> slots;             // value -> index + 1 into bitmaps, 0 when absent
+    std::vector<u16> values;            // value of each bitmap
+    std::vector<log_bitmap_t> bitmaps;
+} log_bitmap_set_t;
+//********************************************************************************************
+// Rows have to be added in increasing order
+void log_bitmap_add(log_bitmap_t& bitmap, u16 row);
+// words |= bitmap and words &= ~bitmap on a dense LOG_BITMAP_WORDS mask
+void log_bitmap_or(const log_bitmap_t& bitmap, u64* words);
+void log_bitmap_andnot(const log_bitmap_t& bitmap, u64* words);
+void log_bitmap_set_add(log_bitmap_set_t& set, u16 value, u16 row);
+void log_bitmap_set_clear(log_bitmap_set_t& set);
+//********************************************************************************************
+inline u32 log_bitmap_ctz(u64 word)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (u32)index;
+#else
+    return (u32)__builtin_ctzll(word);
+#endif
+}
+//********************************************************************************************
+
+#endif // LOG_BITMAP_H
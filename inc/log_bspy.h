@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef LOG_BSPY_H
+#define LOG_BSPY_H
+
+// INTERNAL INCLUDES
+#include "types.h"
+#include "log_store.h"
+
+#define BSPY_MAGIC "BSPYLOG"
+#define BSPY_VERSION 1
+#define BSPY_BLOCK_ROWS 4096            // rows per block at most
+#define BSPY_BLOCK_TEXT (1024 * 1024)   // content bytes after which a block is closed
+
+//********************************************************************************************
+typedef enum bspy_compression_e
+{
+    BSPY_COMPRESSION_NONE,
+    BSPY_COMPRESSION_LZ
+} bspy_compression_e;
+//********************************************************************************************
+// Layout of a .bspy capture, all little endian and 8 byte aligned:
+//   file header
+//   blocks: block header, timestamp offsets (u64), content lengths (u32), origins (u16),
+//           severities (u8), content arena, each column padded to 8 bytes. The part after
+//           the header is stored LZ compressed when that makes it smaller.
+//   origin table: u16 length + name per origin, indexed by the origin column
+//   block index: one entry per block
+//   trailer
+typedef struct bspy_file_header_t
+{
+    char magic[8];
+    u32 version;
+    u32 flags;
+} bspy_file_header_t;
+//********************************************************************************************
+typedef struct bspy_block_header_t
+{
+    u64 min_timestamp;      // timestamps are stored as offsets from this
+    u64 max_timestamp;
+    u32 count;
+    u32 content_bytes;
+    u32 payload_bytes;      // bytes following the header as stored
+    u8 severity_mask;       // bit per log_severity_e present in the block
+    u8 compression;         // bspy_compression_e
+    u8 reserved[2];
+} bspy_block_header_t;
+//********************************************************************************************
+typedef struct bspy_index_entry_t
+{
+    u64 offset;             // of the block header from the start of the file
+    bspy_block_header_t header;
+} bspy_index_entry_t;
+//********************************************************************************************
+typedef struct bspy_trailer_t
+{
+    u64 origins_offset;
+    u64 index_offset;
+    u32 origin_count;
+    u32 block_count;
+    char magic[8];
+} bspy_trailer_t;
+//********************************************************************************************
+bool save_logs_to_bspy(const char* filename, const log_snapshot_t& snapshot, log_progress_t* progress);
+bool load_logs_from_bspy(const char* filename, log_store_t& logs);
+//********************************************************************************************
+
+#endif // LOG_BSPY_H
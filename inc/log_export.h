@@ -0,0 +1,59 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef LOG_EXPORT_H
+#define LOG_EXPORT_H
+
+// EXTERNAL INCLUDES
+#include <atomic>
+#include <deque>
+#include <string>
+#include <thread>
+// INTERNAL INCLUDES
+#include "types.h"
+#include "log_store.h"
+
+//********************************************************************************************
+// Saves a snapshot of the store on a background thread. Ingestion keeps appending to
+// the store meanwhile, the snapshot only sees entries that existed when it was taken.
+typedef struct log_export_t
+{
+    std::thread thread;
+    log_snapshot_t snapshot;
+    log_progress_t progress;
+    u64 total = 0;                  // rows in the snapshot
+    std::string filename;
+    std::atomic<bool> finished;
+    bool succeeded = false;         // valid once finished
+    void (*notify)(void* user) = NULL;  // called by the export thread once finished is set
+    void* notify_user = NULL;
+} log_export_t;
+//********************************************************************************************
+// ids limits the export to those entries, NULL exports everything
+bool log_export_start(log_export_t& exporter, log_store_t& store, const std::deque<u64>* ids, const char* filename);
+bool log_export_busy(const log_export_t& exporter);
+// True once after the export ended, joins the thread and reports whether it succeeded
+bool log_export_poll(log_export_t& exporter, bool& succeeded);
+void log_export_cancel(log_export_t& exporter);
+float log_export_fraction(const log_export_t& exporter);
+//********************************************************************************************
+
+#endif // LOG_EXPORT_H
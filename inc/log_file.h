@@ -0,0 +1,39 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef LOG_FILE_H
+#define LOG_FILE_H
+
+// INTERNAL INCLUDES
+#include "types.h"
+#include "log_store.h"
+
+//********************************************************************************************
+bool save_logs_to_csv(const char* filename, const log_snapshot_t& snapshot, log_progress_t* progress);
+bool load_logs_from_csv(const char* filename, log_store_t& logs);
+bool save_logs_to_jsonl(const char* filename, const log_snapshot_t& snapshot, log_progress_t* progress);
+// Pick the format from the extension: .bspy is binary, .jsonl JSON Lines and anything
+// else CSV. Saving reads a snapshot so it can run off the UI thread; progress may be NULL.
+bool save_logs_to_file(const char* filename, const log_snapshot_t& snapshot, log_progress_t* progress);
+bool load_logs_from_file(const char* filename, log_store_t& logs);
+//********************************************************************************************
+
+#endif // LOG_FILE_H
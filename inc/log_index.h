@@ -0,0 +1,70 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef LOG_INDEX_H
+#define LOG_INDEX_H
+
+// EXTERNAL INCLUDES
+#include <stddef.h>
+// INTERNAL INCLUDES
+#include "types.h"
+#include "log_store.h"
+
+// Rows of a segment that share one posting, candidates are verified a group at a time
+#define LOG_INDEX_GROUP_ROWS 64
+#define LOG_INDEX_GROUP_BITS 10
+#define LOG_INDEX_GROUPS (LOG_SEGMENT_CAPACITY / LOG_INDEX_GROUP_ROWS)
+#define LOG_INDEX_GROUP_WORDS (LOG_INDEX_GROUPS / 64)
+// Bits of the trigram hash, together with the group they fill a u32 key
+#define LOG_INDEX_HASH_BITS (32 - LOG_INDEX_GROUP_BITS)
+
+//********************************************************************************************
+// Trigram index of the content of full segments. Every key is the hash of a trigram in
+// its upper bits and the row group containing it in the lower bits, so the postings of
+// a trigram are one sorted range of the segment's key array. Trigrams are folded to
+// lower case, so the same keys serve case sensitive and insensitive searches. The
+// segment still being appended to is not indexed and scanned instead.
+typedef struct log_group_set_t
+{
+    u64 bits[LOG_INDEX_GROUP_WORDS];
+} log_group_set_t;
+//********************************************************************************************
+// Installs finished indexes and starts new ones, called once per frame. Returns the
+// number of indexes installed.
+u32 log_index_update(log_store_t& store);
+// Row groups of the segment that may contain token. False when the index cannot tell,
+// because the segment is not indexed yet or the token is shorter than a trigram.
+bool log_index_candidates(const log_segment_t& segment, const char* token, size_t length, log_group_set_t& groups);
+// Row groups that may contain token with up to max_edits edits
+bool log_index_fuzzy_candidates(
+    const log_segment_t& segment,
+    const char* token,
+    size_t length,
+    u32 max_edits,
+    log_group_set_t& groups);
+//********************************************************************************************
+inline bool log_group_test(const log_group_set_t& groups, u32 group)
+{
+    return (groups.bits[group >> 6] >> (group & 63)) & 1;
+}
+//********************************************************************************************
+
+#endif // LOG_INDEX_H
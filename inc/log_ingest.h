@@ -0,0 +1,81 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef LOG_INGEST_H
+#define LOG_INGEST_H
+
+// EXTERNAL INCLUDES
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+// INTERNAL INCLUDES
+#include "types.h"
+#include "log_store.h"
+
+// Size of the raw message queue between the window thread and the parser, power of two
+#define LOG_INGEST_QUEUE_SIZE (16 * 1024 * 1024)
+// Parsed entries collected before a batch is handed to the UI
+#define LOG_INGEST_BATCH_ENTRIES 65536
+
+//********************************************************************************************
+typedef enum log_ingest_kind_e
+{
+    LOG_INGEST_RECORD = 1,      // single "timestamp,severity,origin,content" record
+    LOG_INGEST_LINES = 2,       // any number of newline separated records
+    LOG_INGEST_WRAP = 0xFFFF    // padding up to the end of the queue
+} log_ingest_kind_e;
+//********************************************************************************************
+// Raw payloads are copied into a preallocated single-producer/single-consumer ring by
+// the window thread and parsed on a dedicated thread. Parsed batches are picked up by
+// the UI once per frame.
+typedef struct log_ingest_t
+{
+    std::unique_ptr<char[]> queue;
+    alignas(64) std::atomic<u64> head;  // bytes written, advanced by the producer
+    alignas(64) std::atomic<u64> tail;  // bytes consumed, advanced by the parser
+    alignas(64) std::atomic<bool> running;
+    std::atomic<bool> parser_waiting;
+    std::mutex wake_mutex;
+    std::condition_variable wake;
+    std::thread parser;
+
+    std::mutex batch_mutex;             // guards ready and spare
+    std::vector<log_batch_t*> ready;    // parsed, waiting for the UI
+    std::vector<log_batch_t*> spare;    // consumed by the UI, kept for reuse
+    std::vector<log_batch_t*> taken;    // batches being appended by the UI
+    std::atomic<u64> rejected;          // messages larger than half the queue, never queued
+    void (*notify)(void* user) = NULL;  // called by the publishing thread when ready stops being empty
+    void* notify_user = NULL;
+} log_ingest_t;
+//********************************************************************************************
+void log_ingest_start(log_ingest_t& ingest);
+void log_ingest_stop(log_ingest_t& ingest);
+bool log_ingest_push(log_ingest_t& ingest, log_ingest_kind_e kind, const void* data, size_t length);
+void log_ingest_parse(log_batch_t& batch, u32 kind, const char* data, size_t length);
+void log_ingest_publish(log_ingest_t& ingest, log_batch_t* batch);
+log_batch_t* log_ingest_acquire_batch(log_ingest_t& ingest);
+u64 log_ingest_drain(log_ingest_t& ingest, log_store_t& store);
+//********************************************************************************************
+
+#endif // LOG_INGEST_H
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef LOG_PARSER_H
+#define LOG_PARSER_H
+
+// EXTERNAL INCLUDES
+#include <stddef.h>
+// INTERNAL INCLUDES
+#include "types.h"
+#include "log_store.h"
+
+//********************************************************************************************
+// Fields of a single "timestamp,severity,origin,content" record. Origin and content
+// point into the parsed buffer, nothing is copied. Quoted fields are returned without
+// their quotes but still contain doubled quotes until passed through csv_unescape.
+typedef struct log_record_t
+{
+    u64 timestamp;
+    log_severity_e severity;
+    const char* origin;
+    u32 origin_length;
+    const char* content;
+    u32 content_length;
+    bool origin_escaped;
+    bool content_escaped;
+} log_record_t;
+//********************************************************************************************
+log_severity_e log_parse_severity(const char* str, size_t length);
+// True when p starts with a numeric timestamp and a known severity field. Used to tell
+// records from other text, the rest of the line is not checked.
+bool log_looks_like_record(const char* p, const char* end);
+// Seconds, milliseconds, microseconds or nanoseconds told apart by magnitude, or
+// "seconds.fraction". Returns nanoseconds.
+u64 log_parse_timestamp(const char* str, size_t length);
+const char* log_parse_line(const char* data, const char* end, log_record_t& record, bool& valid);
+bool log_parse_record(const char* data, size_t length, log_record_t& record);
+u32 log_parse_lines(const char* data, size_t length, log_batch_t& batch);
+void log_batch_add_record(log_batch_t& batch, const log_record_t& record);
+//********************************************************************************************
+
+#endif // LOG_PARSER_H
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef LOG_QUERY_H
+#define LOG_QUERY_H
+
+// EXTERNAL INCLUDES
+#include <memory>
+#include <regex>
+#include <string>
+#include <vector>
+// INTERNAL INCLUDES
+#include "types.h"
+#include "fuzzy_match.h"
+#include "log_store.h"
+
+//********************************************************************************************
+typedef enum log_query_op_e
+{
+    QUERY_AND,
+    QUERY_OR,
+    QUERY_NOT,
+    QUERY_TEXT,         // word or quoted phrase in the content
+    QUERY_REGEX,        // /regex/ searched in the content
+    QUERY_ORIGIN,       // origin:name, substring of the origin
+    QUERY_SEVERITY,     // sev>=WARN and friends
+    QUERY_TIME          // ts:[a,b], inclusive, either end may be left out
+} log_query_op_e;
+//********************************************************************************************
+typedef struct log_query_node_t
+{
+    log_query_op_e op;
+    std::vector<u32> children;                  // in evaluation order once planned
+    std::string text;                           // phrase or origin substring
+    std::shared_ptr<const std::regex> regex;
+    std::shared_ptr<const fuzzy_pattern_t> fuzzy;   // set in fuzzy mode
+    u8 severities = 0;                          // bit per matching severity
+    u64 time_min = 0;
+    u64 time_max = ~0ull;
+    std::vector<u8> origin_matches;             // per interned origin, for QUERY_ORIGIN
+    bool exact = false;                         // the row mask of the node needs no verification
+    float cost = 1.0f;                          // estimated work per row
+    float selectivity = 0.5f;                   // estimated fraction of rows that match
+} log_query_node_t;
+//********************************************************************************************
+// Filter query compiled into a tree of predicates:
+//
+//   origin:renderer sev>=WARN ts:[1000,2000] "exact phrase" /time(out|d out)/
+//   (crash OR abort) AND NOT origin:test
+//
+// Terms next to each other are joined by AND, a comma joins them by OR. NOT can also be
+// written as a leading '!'. Plain words and phrases search the content only. A filter
+// without any of this syntax, or one that fails to parse, is left to the comma
+// separated substring filter.
+typedef struct log_query_t
+{
+    std::vector<log_query_node_t> nodes;
+    u32 root = 0;
+    bool active = false;                        // the filter uses the query syntax
+    bool ignore_case = false;                   // text, origins and regex ignore ASCII case
+    u32 max_edits = 0;                          // fuzzy text terms, 0 for exact
+    std::string error;                          // why the filter was not taken as a query
+} log_query_t;
+//********************************************************************************************
+// Parses text, sets active when it uses the query syntax. False with error set when it
+// looks like a query but cannot be compiled, active stays false so the text is matched
+// as plain substrings instead. Text terms allow max_edits edits when not 0.
+bool log_query_compile(log_query_t& query, const char* text, bool ignore_case, u32 max_edits);
+// Evaluates origin predicates for the origins interned since the last call
+void log_query_update_origins(log_query_t& query, const std::vector<std::string>& origin_names);
+// Estimates the selectivity of every predicate on the store and orders the operands of
+// AND and OR so that cheap predicates likely to decide the result run first
+void log_query_plan(log_query_t& query, const log_store_t& store);
+// Narrows rows, a LOG_BITMAP_WORDS row mask of the segment, to the rows that may match
+// using the severity and origin bitmaps and the trigram index
+void log_query_rows(const log_query_t& query, const log_segment_t& segment, u64* rows);
+// Verifies a row left by log_query_rows, text is the content base of the segment
+bool log_query_match(const log_query_t& query, const log_segment_t& segment, const char* text, u32 index);
+//********************************************************************************************
+
+#endif // LOG_QUERY_H
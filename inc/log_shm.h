@@ -0,0 +1,105 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef LOG_SHM_H
+#define LOG_SHM_H
+
+// EXTERNAL INCLUDES
+#include <atomic>
+#include <stddef.h>
+#include <thread>
+#if !defined(_WIN32)
+#include <semaphore.h>
+#endif
+// INTERNAL INCLUDES
+#include "types.h"
+#include "log_ingest.h"
+
+#define LOG_SHM_MAGIC 0x59505342 // "BSPY"
+#define LOG_SHM_VERSION 1
+#define LOG_SHM_DEFAULT_CAPACITY (32 * 1024 * 1024)
+#if defined(_WIN32)
+#define LOG_SHM_DEFAULT_NAME "Local\\bSpyLogRing"
+#else
+#define LOG_SHM_DEFAULT_NAME "/bspy_log_ring"
+#endif
+// Longest the reader sleeps without a signal, in case a producer cannot signal
+#define LOG_SHM_IDLE_WAIT_MS 1000
+
+//********************************************************************************************
+// Layout at the start of the shared mapping, the ring data follows at LOG_SHM_DATA_OFFSET.
+// Records are framed as log_shm_record_t followed by the payload, padded to 8 bytes.
+// A record that does not fit before the end of the ring is preceded by a
+// LOG_INGEST_WRAP record covering the remaining space. One producer, one reader.
+// An idle reader sets reader_waiting and sleeps on the "<name>_ready" event (Win32) or
+// semaphore (POSIX), which the producer signals after writing while the flag is set.
+typedef struct log_shm_header_t
+{
+    u32 magic;
+    u32 version;
+    u64 capacity;                       // ring data bytes, power of two
+    alignas(64) std::atomic<u64> head;  // bytes written, advanced by the producer
+    alignas(64) std::atomic<u64> tail;  // bytes consumed, advanced by bSpy
+    alignas(64) std::atomic<u64> dropped; // records the producer could not fit
+    std::atomic<u32> reader_waiting;    // reader sleeps until signalled
+} log_shm_header_t;
+//********************************************************************************************
+typedef struct log_shm_record_t
+{
+    u32 length;
+    u32 kind;   // log_ingest_kind_e
+} log_shm_record_t;
+
+#define LOG_SHM_DATA_OFFSET 256
+
+//********************************************************************************************
+typedef struct log_shm_t
+{
+    log_shm_header_t* header = NULL;
+    char* data = NULL;
+    size_t mapping_size = 0;
+    bool owner = false;                 // created the mapping, responsible for removing it
+#if defined(_WIN32)
+    void* mapping = NULL;
+    void* owner_lock = NULL;            // named mutex held by the bSpy reading the ring
+    void* ready = NULL;                 // auto-reset event waking the reader
+#else
+    int fd = -1;
+    char name[64] = {};
+    sem_t* ready = NULL;                // semaphore waking the reader
+#endif
+    std::thread reader;
+    std::atomic<bool> running;
+} log_shm_t;
+//********************************************************************************************
+// Fails when another bSpy already reads a ring of that name. A region left behind by a
+// session that ended is taken over.
+bool log_shm_create(log_shm_t& shm, const char* name, u64 capacity);
+bool log_shm_open(log_shm_t& shm, const char* name);
+void log_shm_close(log_shm_t& shm);
+bool log_shm_write(log_shm_t& shm, log_ingest_kind_e kind, const void* data, size_t length);
+// Records producers could not fit into the ring since it was created
+u64 log_shm_dropped(const log_shm_t& shm);
+void log_shm_start_reader(log_shm_t& shm, log_ingest_t& ingest);
+void log_shm_stop_reader(log_shm_t& shm);
+//********************************************************************************************
+
+#endif // LOG_SHM_H
@@ -0,0 +1,316 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef LOG_STORE_H
+#define LOG_STORE_H
+
+// EXTERNAL INCLUDES
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+// INTERNAL INCLUDES
+#include "types.h"
+#include "log_bitmap.h"
+
+// Maximum number of entries held by one segment, keeps local indices in 16 bits
+#define LOG_SEGMENT_CAPACITY 65536
+// Origin id used once the origin table is full
+#define LOG_ORIGIN_OVERFLOW 0xFFFE
+// Longer origin names are cut when interned, the .bspy origin table stores u16 lengths
+#define LOG_ORIGIN_MAX_LENGTH 0xFFFF
+// Column bytes held per entry in addition to its content, used for the byte budget
+#define LOG_ENTRY_OVERHEAD (sizeof(u64) + sizeof(u8) + sizeof(u16) + 2 * sizeof(u32))
+// Newest segments that are never compressed
+#define LOG_HOT_SEGMENTS 2
+// Segments compressed in the background at the same time
+#define LOG_PACK_JOBS 2
+// Timestamps are nanoseconds since the Unix epoch
+#define LOG_NS_PER_SECOND 1000000000ull
+
+//********************************************************************************************
+typedef enum log_severity_e
+{
+    INFO,
+    WARN,
+    FAIL,
+    SUCC,
+    CRIT,
+    DBUG,
+    TRCE
+} log_severity_e;
+//********************************************************************************************
+// URL in the content of an entry, a link runs from "http://" or "https://" to whitespace
+typedef struct log_link_t
+{
+    u32 row;                // index of the entry in its segment
+    u32 begin;              // offset from the start of the content
+    u32 length;
+} log_link_t;
+//********************************************************************************************
+// Columnar block of consecutive log entries. Content of all entries is appended to a
+// single text arena and addressed by offset, origins are stored as interned ids.
+// Segments filled from a mapped file address the file directly instead of the arena.
+// Cold segments keep their content compressed in packed and unpack it on first access
+// into an external copy, which is dropped again once the segment is no longer used.
+typedef struct log_segment_t
+{
+    u64 first_id;                       // id of the first entry in this segment
+    u32 count;
+    std::vector<u64> timestamps;
+    std::vector<u8> severities;
+    std::vector<u16> origins;
+    std::vector<u32> content_offsets;   // offset of the content in text
+    std::vector<u32> content_lengths;
+    std::vector<char> text;             // content arena
+    mutable const char* external_text = NULL;   // content base when it lives outside the arena
+    mutable std::shared_ptr<const void> source; // keeps external_text alive
+    std::vector<char> packed;                   // compressed content of a cold segment
+    u32 text_bytes = 0;                         // unpacked size of packed
+    mutable bool touched = false;               // content read since the last compaction
+    bool sealed = false;                        // no further appends, a snapshot reads it
+    std::vector<u32> trigram_keys;              // see log_index.h, sorted
+    bool indexed = false;                       // trigram_keys is complete
+    log_bitmap_set_t severity_rows;             // rows of every severity
+    log_bitmap_set_t origin_rows;               // rows of every origin id
+    std::vector<log_link_t> links;              // found on append, ordered by row
+} log_segment_t;
+//********************************************************************************************
+// Lightweight view of a single entry, pointers stay valid until the store is modified
+typedef struct log_entry_ref_t
+{
+    u64 id;
+    u64 timestamp;
+    log_severity_e severity;
+    u16 origin;
+    const char* content;
+    u32 content_length;
+    const log_link_t* links;    // links of this entry, NULL when there are none
+    u32 link_count;
+} log_entry_ref_t;
+//********************************************************************************************
+// Entries parsed off the UI thread, waiting to be appended to the store. Origin and
+// content are both kept in the batch text arena because origins are interned on append.
+typedef struct log_batch_t
+{
+    u32 count;
+    std::vector<u64> timestamps;
+    std::vector<u8> severities;
+    std::vector<u32> origin_offsets;
+    std::vector<u32> origin_lengths;
+    std::vector<u32> content_offsets;
+    std::vector<u32> content_lengths;
+    std::vector<char> text;
+} log_batch_t;
+//********************************************************************************************
+// Limits applied on every append, oldest entries are evicted first. Zero means unlimited.
+// Memory is only released per segment of LOG_SEGMENT_CAPACITY entries, so max_bytes also
+// counts evicted entries whose segment is still held; reaching it drops the rest of that
+// segment at once.
+typedef struct log_retention_t
+{
+    u64 max_entries;
+    u64 max_bytes;      // content plus LOG_ENTRY_OVERHEAD per entry
+    u64 max_age;        // seconds behind the newest timestamp
+} log_retention_t;
+//********************************************************************************************
+// Content of a cold segment being compressed on the thread pool
+typedef struct log_pack_job_t
+{
+    u64 first_id;                               // segment the result belongs to
+    std::shared_ptr<const std::vector<char>> text;
+    std::vector<char> packed;
+    std::atomic<bool> done;
+} log_pack_job_t;
+//********************************************************************************************
+// Trigram index of a full segment being built on the thread pool. Holding the segment
+// keeps the store from changing it meanwhile.
+typedef struct log_index_job_t
+{
+    std::shared_ptr<const log_segment_t> segment;
+    std::vector<u32> keys;
+    std::atomic<bool> done;
+} log_index_job_t;
+//********************************************************************************************
+// Entries are addressed by a monotonically increasing id. The segments form a ring:
+// new segments are pushed at the back, eviction advances first_id and releases the
+// front segment once all of its entries are gone. Segments are shared with snapshots,
+// a segment referenced by a snapshot is never modified.
+typedef struct log_store_t
+{
+    std::deque<std::shared_ptr<log_segment_t>> segments;
+    std::shared_ptr<log_segment_t> spare;   // released segment kept for reuse
+    std::vector<std::string> origin_names;  // indexed by origin id
+    std::vector<u16> origin_slots;          // open addressing hash table of origin ids
+    u16 last_origin = 0;                    // most recently interned origin, checked first
+    u64 first_id = 0;                       // id of the oldest entry in the store
+    u64 next_id = 0;                        // id the next appended entry will receive
+    u64 generation = 0;                     // bumped whenever existing ids become invalid
+    u64 retained_bytes = 0;                 // content plus overhead of the entries in the store
+    u64 evicted_bytes = 0;                  // evicted from the front segment, held until it is released
+    u64 newest_timestamp = 0;
+    u64 dropped = 0;                        // entries evicted by the retention policy
+    log_retention_t retention = {};
+    bool compress_cold = false;             // pack segments older than LOG_HOT_SEGMENTS
+    std::vector<std::shared_ptr<log_pack_job_t>> pack_jobs;
+    std::vector<std::shared_ptr<log_index_job_t>> index_jobs;
+} log_store_t;
+//********************************************************************************************
+// Consistent copy of the store for readers on other threads. Holds the segments that
+// existed when it was taken; the store seals the newest one so it stops changing.
+// A filtered snapshot only covers the listed ids.
+typedef struct log_snapshot_t
+{
+    std::vector<std::shared_ptr<const log_segment_t>> segments;
+    std::vector<std::string> origin_names;
+    u64 first_id;
+    u64 next_id;
+    bool filtered;
+    std::vector<u64> ids;           // ascending, only used when filtered
+} log_snapshot_t;
+//********************************************************************************************
+// Walks the rows of a snapshot in id order
+typedef struct log_snapshot_cursor_t
+{
+    const log_snapshot_t* snapshot;
+    size_t segment;                 // current segment
+    u32 index;                      // next local index when walking all rows
+    size_t position;                // next entry of ids when filtered
+    const char* text;               // content base of the current segment
+    std::vector<char> scratch;
+} log_snapshot_cursor_t;
+//********************************************************************************************
+// Progress of a background reader of a snapshot, polled and cancelled by the UI
+typedef struct log_progress_t
+{
+    std::atomic<u64> rows;
+    std::atomic<bool> cancel;
+} log_progress_t;
+//********************************************************************************************
+// Rows a reader processes between progress updates, power of two
+#define LOG_PROGRESS_STEP 4096
+//********************************************************************************************
+const char* severity_to_string(log_severity_e severity);
+u16 log_store_intern_origin(log_store_t& store, const char* origin, size_t length);
+u64 log_store_append(
+    log_store_t& store,
+    u64 timestamp,
+    log_severity_e severity,
+    const char* origin,
+    size_t origin_length,
+    const char* content,
+    size_t content_length
+);
+u64 log_store_append_interned(
+    log_store_t& store,
+    u64 timestamp,
+    log_severity_e severity,
+    u16 origin,
+    const char* content,
+    size_t content_length
+);
+u64 log_store_append_external(
+    log_store_t& store,
+    const std::shared_ptr<const void>& source,
+    u64 timestamp,
+    log_severity_e severity,
+    u16 origin,
+    const char* content,
+    size_t content_length
+);
+void log_store_append_batch(log_store_t& store, const log_batch_t& batch);
+void log_store_clear(log_store_t& store);
+// Clears store and takes over the entries and origins of loaded, which is left empty.
+// Entry ids continue after the ones store handed out before.
+void log_store_replace(log_store_t& store, log_store_t& loaded);
+void log_store_set_retention(log_store_t& store, const log_retention_t& retention);
+void log_store_evict_front(log_store_t& store);
+// Installs finished pack jobs, releases unused unpacked copies and packs cold segments.
+// Returns the number of finished pack jobs taken off the store.
+u32 log_store_compact(log_store_t& store);
+void log_segment_unpack(const log_segment_t& segment);
+// Content base of a segment without touching its unpack cache, safe from other threads
+// while a snapshot holds the segment. Packed content is unpacked into scratch.
+const char* log_segment_read_text(const log_segment_t& segment, std::vector<char>& scratch);
+void log_store_snapshot(log_store_t& store, log_snapshot_t& snapshot);
+void log_snapshot_cursor_init(log_snapshot_cursor_t& cursor, const log_snapshot_t& snapshot);
+bool log_snapshot_next(log_snapshot_cursor_t& cursor, const log_segment_t*& segment, u32& index);
+size_t log_store_segment_index(const log_store_t& store, u64 id);
+const log_segment_t* log_store_find_segment(const log_store_t& store, u64 id);
+bool log_store_get(const log_store_t& store, u64 id, log_entry_ref_t& entry);
+//********************************************************************************************
+// Bytes accounted against max_bytes, including evicted entries still held in memory
+inline u64 log_store_held_bytes(const log_store_t& store)
+{
+    return store.retained_bytes + store.evicted_bytes;
+}
+//********************************************************************************************
+inline u64 log_store_size(const log_store_t& store)
+{
+    return store.next_id - store.first_id;
+}
+//********************************************************************************************
+inline const std::string& log_store_origin(const log_store_t& store, u16 origin)
+{
+    return store.origin_names[origin];
+}
+//********************************************************************************************
+void log_batch_add(
+    log_batch_t& batch,
+    u64 timestamp,
+    log_severity_e severity,
+    const char* origin,
+    size_t origin_length,
+    const char* content,
+    size_t content_length
+);
+void log_batch_clear(log_batch_t& batch);
+//********************************************************************************************
+inline u32 log_segment_begin(const log_store_t& store, const log_segment_t& segment)
+{
+    // Local index of the first entry that has not been evicted yet
+    return store.first_id > segment.first_id ? (u32)(store.first_id - segment.first_id) : 0;
+}
+//********************************************************************************************
+// Adds rows to the progress, false once the reader should stop
+inline bool log_progress_step(log_progress_t* progress, u64 rows)
+{
+    if (!progress)
+        return true;
+    progress->rows.fetch_add(rows, std::memory_order_relaxed);
+    return !progress->cancel.load(std::memory_order_relaxed);
+}
+//********************************************************************************************
+inline const char* log_segment_content(const log_segment_t& segment, u32 index)
+{
+    if (!segment.packed.empty())
+    {
+        segment.touched = true;
+        if (!segment.external_text)
+            log_segment_unpack(segment);
+    }
+    const char* base = segment.external_text ? segment.external_text : segment.text.data();
+    return base + segment.content_offsets[index];
+}
+//********************************************************************************************
+
+#endif // LOG_STORE_H
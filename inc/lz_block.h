@@ -0,0 +1,45 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef LZ_BLOCK_H
+#define LZ_BLOCK_H
+
+// EXTERNAL INCLUDES
+#include <stddef.h>
+// INTERNAL INCLUDES
+#include "types.h"
+
+//********************************************************************************************
+// Self-contained compressor for the LZ4 block format. Greedy matching with a single
+// hash table, tuned for speed over ratio; repetitive log text still shrinks several times.
+//********************************************************************************************
+// Worst case compressed size, lz_compress needs at least this much room
+inline size_t lz_compress_bound(size_t size)
+{
+    return size + size / 255 + 16;
+}
+//********************************************************************************************
+size_t lz_compress(const char* src, size_t size, char* dst, size_t capacity);
+// Fails unless the input decodes to exactly raw_size bytes
+bool lz_decompress(const char* src, size_t size, char* dst, size_t raw_size);
+//********************************************************************************************
+
+#endif // LZ_BLOCK_H
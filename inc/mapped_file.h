@@ -0,0 +1,61 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+// EXTERNAL INCLUDES
+#include <memory>
+#include <stddef.h>
+#include <string>
+// INTERNAL INCLUDES
+#include "types.h"
+
+//********************************************************************************************
+// Private copy-on-write view of a whole file, writes never reach the disk and only the
+// touched pages are copied. Shared so that log segments pointing into it keep the
+// mapping alive.
+typedef struct mapped_file_t
+{
+    char* data;
+    size_t size;
+    u64 device;         // identifies the file regardless of the path used to open it
+    u64 index;
+#if defined(_WIN32)
+    void* file;
+    void* mapping;
+#else
+    int fd;
+#endif
+} mapped_file_t;
+//********************************************************************************************
+std::shared_ptr<mapped_file_t> mapped_file_open(const char* filename);
+// True while a mapping of the file is alive. Writing to it then would change or, once
+// truncated, fault the pages that log segments still read.
+bool mapped_file_in_use(const char* filename);
+// Saves go to a temporary file next to the target, which replaces the target only once
+// complete. A failed or cancelled save leaves an existing target untouched.
+std::string file_temp_name(const char* filename);
+// Renames temp over target when saved, otherwise removes temp. True if target was replaced.
+bool file_commit(const char* temp, const char* target, bool saved);
+//********************************************************************************************
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef MULTI_MATCH_H
+#define MULTI_MATCH_H
+
+// EXTERNAL INCLUDES
+#include <stddef.h>
+#include <string>
+#include <vector>
+// INTERNAL INCLUDES
+#include "types.h"
+
+// Patterns sharing one bit of the fingerprint tables
+#define MULTI_MATCH_BUCKETS 8
+
+//********************************************************************************************
+typedef enum multi_match_level_e
+{
+    MULTI_MATCH_SCALAR,
+    MULTI_MATCH_SSE42,
+    MULTI_MATCH_AVX2
+} multi_match_level_e;
+//********************************************************************************************
+// Finds any of a set of patterns in one pass over the text, in the style of Teddy: the
+// first two bytes of every pattern set its bucket bit in per-byte tables, positions
+// where both bytes agree on a bucket are verified against the patterns of that bucket.
+// The vector paths look the tables up by nibble with a byte shuffle, 16 or 32 positions
+// at a time. Every pattern carries flags, a search reports the flags of the patterns
+// it found. Ignoring case, patterns are folded to lower case and both cases of a letter
+// set the tables.
+typedef struct multi_match_t
+{
+    std::vector<std::string> patterns;
+    std::vector<u8> flags;                              // flags of each pattern
+    std::vector<u32> buckets[MULTI_MATCH_BUCKETS];      // pattern indices of each bucket
+    u8 first[256];                                      // buckets by first byte
+    u8 second[256];                                     // buckets by second byte
+    u8 short_buckets;                                   // buckets holding 1-byte patterns
+    u8 empty_flags;                                     // flags of empty patterns
+    u8 all_flags;
+    bool ignore_case;
+    alignas(16) u8 first_lo[16];                        // first by low and high nibble
+    alignas(16) u8 first_hi[16];
+    alignas(16) u8 second_lo[16];
+    alignas(16) u8 second_hi[16];
+} multi_match_t;
+//********************************************************************************************
+void multi_match_clear(multi_match_t& matcher);
+void multi_match_add(multi_match_t& matcher, const char* pattern, size_t length, u8 flags);
+// Fills the lookup tables, call once all patterns were added
+void multi_match_build(multi_match_t& matcher, bool ignore_case);
+// Flags of the patterns found in text, limited to wanted. Stops once all wanted flags
+// were found.
+u8 multi_match_find(const multi_match_t& matcher, const char* text, size_t length, u8 wanted);
+// Same search on the given instruction set, which must not exceed multi_match_max_level().
+// Lets tests and benchmarks compare the paths.
+u8 multi_match_find_with(
+    const multi_match_t& matcher,
+    const char* text,
+    size_t length,
+    u8 wanted,
+    multi_match_level_e level
+);
+// Instruction set multi_match_find uses, the fastest one measured that this CPU supports
+multi_match_level_e multi_match_level(void);
+// Highest instruction set this CPU supports, detected on first use
+multi_match_level_e multi_match_max_level(void);
+//********************************************************************************************
+
+#endif // MULTI_MATCH_H
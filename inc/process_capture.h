@@ -0,0 +1,60 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef PROCESS_CAPTURE_H
+#define PROCESS_CAPTURE_H
+
+// EXTERNAL INCLUDES
+#include <atomic>
+#include <thread>
+// INTERNAL INCLUDES
+#include "types.h"
+#include "log_ingest.h"
+
+//********************************************************************************************
+// Child process whose stdout and stderr are read through pipes on two threads. Lines in
+// the record format are ingested as is, anything else is logged under "stdout"/"stderr".
+typedef struct process_capture_t
+{
+#if defined(_WIN32)
+    void* process = NULL;
+    void* pipes[2] = { NULL, NULL };    // read ends of stdout and stderr
+#else
+    int pid = 0;
+    int pipes[2] = { -1, -1 };
+#endif
+    std::thread readers[2];
+    std::atomic<bool> reader_done[2];
+    std::atomic<bool> running;
+} process_capture_t;
+//********************************************************************************************
+bool process_capture_start(
+    process_capture_t& capture,
+    const char* application,
+    const char* command_line,
+    log_ingest_t& ingest
+);
+bool process_capture_running(process_capture_t& capture);
+void process_capture_kill(process_capture_t& capture);
+void process_capture_stop(process_capture_t& capture);
+//********************************************************************************************
+
+#endif // PROCESS_CAPTURE_H
@@ -0,0 +1,183 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef TEXT_SCAN_H
+#define TEXT_SCAN_H
+
+// EXTERNAL INCLUDES
+#include <string.h>
+#if defined(_M_X64) || defined(_M_AMD64) || defined(__SSE2__)
+#define TEXT_SCAN_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+// INTERNAL INCLUDES
+#include "types.h"
+
+//********************************************************************************************
+inline u32 scan_ctz(u32 mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (u32)index;
+#else
+    return (u32)__builtin_ctz(mask);
+#endif
+}
+//********************************************************************************************
+inline const char* scan_find(const char* p, const char* end, char c)
+{
+    // The CRT memchr is already vectorised. The guard also keeps a negative length, which
+    // GCC cannot rule out after inlining, from reaching it as a huge size_t.
+    if (p >= end)
+        return end;
+    const char* found = (const char*)memchr(p, c, (size_t)(end - p));
+    return found ? found : end;
+}
+//********************************************************************************************
+// First occurrence of token in text, or NULL
+inline const char* scan_find_text(const char* text, size_t length, const char* token, size_t token_length)
+{
+    if (token_length == 0)
+        return text;
+    if (token_length > length)
+        return NULL;
+
+    const char first = token[0];
+    const char* last = text + length - token_length;
+    for (const char* p = text; p <= last; ++p)
+    {
+        p = (const char*)memchr(p, first, last - p + 1);
+        if (!p)
+            return NULL;
+        if (memcmp(p, token, token_length) == 0)
+            return p;
+    }
+    return NULL;
+}
+//********************************************************************************************
+// ASCII lower case of c
+inline char scan_fold(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+//********************************************************************************************
+// True when the length bytes at text equal folded, which is already lower case,
+// ignoring ASCII case
+inline bool scan_equal_folded(const char* text, const char* folded, size_t length)
+{
+    size_t i = 0;
+#if defined(TEXT_SCAN_SSE2)
+    // Upper case letters are the bytes that land below -128 + 26 once 'A' maps to -128
+    const __m128i bias = _mm_set1_epi8((char)('A' + 128));
+    const __m128i limit = _mm_set1_epi8(-128 + 26);
+    const __m128i flip = _mm_set1_epi8(0x20);
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(text + i));
+        __m128i upper = _mm_cmplt_epi8(_mm_sub_epi8(chunk, bias), limit);
+        chunk = _mm_or_si128(chunk, _mm_and_si128(upper, flip));
+        __m128i equal = _mm_cmpeq_epi8(chunk, _mm_loadu_si128((const __m128i*)(folded + i)));
+        if (_mm_movemask_epi8(equal) != 0xFFFF)
+            return false;
+    }
+#endif
+    for (; i < length; ++i)
+    {
+        if (scan_fold(text[i]) != folded[i])
+            return false;
+    }
+    return true;
+}
+//********************************************************************************************
+// First occurrence of either a or b, or end
+inline const char* scan_find_either(const char* p, const char* end, char a, char b)
+{
+#if defined(TEXT_SCAN_SSE2)
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    while (end - p >= 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)p);
+        u32 mask = (u32)_mm_movemask_epi8(_mm_or_si128(
+            _mm_cmpeq_epi8(chunk, va),
+            _mm_cmpeq_epi8(chunk, vb)));
+        if (mask)
+            return p + scan_ctz(mask);
+        p += 16;
+    }
+#endif
+    while (p < end && *p != a && *p != b)
+        ++p;
+    return p;
+}
+//********************************************************************************************
+// First occurrence of any of a, b, c or d, or end
+inline const char* scan_find_any(const char* p, const char* end, char a, char b, char c, char d)
+{
+#if defined(TEXT_SCAN_SSE2)
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    const __m128i vc = _mm_set1_epi8(c);
+    const __m128i vd = _mm_set1_epi8(d);
+    while (end - p >= 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)p);
+        u32 mask = (u32)_mm_movemask_epi8(_mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, vc), _mm_cmpeq_epi8(chunk, vd))));
+        if (mask)
+            return p + scan_ctz(mask);
+        p += 16;
+    }
+#endif
+    while (p < end && *p != a && *p != b && *p != c && *p != d)
+        ++p;
+    return p;
+}
+//********************************************************************************************
+// First occurrence of folded, a lower case token, in text ignoring ASCII case, or NULL
+inline const char* scan_find_text_folded(const char* text, size_t length, const char* folded, size_t folded_length)
+{
+    if (folded_length == 0)
+        return text;
+    if (folded_length > length)
+        return NULL;
+
+    const char lower = folded[0];
+    const char upper = (lower >= 'a' && lower <= 'z') ? (char)(lower - ('a' - 'A')) : lower;
+    const char* last = text + length - folded_length;
+    for (const char* p = text; p <= last; ++p)
+    {
+        p = scan_find_either(p, last + 1, lower, upper);
+        if (p > last)
+            return NULL;
+        if (scan_equal_folded(p, folded, folded_length))
+            return p;
+    }
+    return NULL;
+}
+//********************************************************************************************
+
+#endif // TEXT_SCAN_H
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+// EXTERNAL INCLUDES
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+// INTERNAL INCLUDES
+#include "types.h"
+
+//********************************************************************************************
+typedef struct thread_pool_t
+{
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+} thread_pool_t;
+//********************************************************************************************
+void thread_pool_start(thread_pool_t& pool, u32 threads);
+void thread_pool_stop(thread_pool_t& pool);
+void thread_pool_submit(thread_pool_t& pool, std::function<void()> task);
+// Runs fn(0..count-1) on the workers and the calling thread, returns once all are done.
+// Must not be called from inside a pool task.
+void thread_pool_parallel_for(thread_pool_t& pool, u32 count, const std::function<void(u32)>& fn);
+// Pool sized to the machine, started on first use
+thread_pool_t& thread_pool_shared(void);
+//********************************************************************************************
+
+#endif // THREAD_POOL_H
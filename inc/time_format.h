@@ -0,0 +1,90 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+#ifndef TIME_FORMAT_H
+#define TIME_FORMAT_H
+
+// EXTERNAL INCLUDES
+// INTERNAL INCLUDES
+#include "types.h"
+
+// Characters of "YYYY-MM-DD HH:MM:SS", without the terminator
+#define TIME_TEXT_LENGTH 19
+// Characters with the longest fraction, "YYYY-MM-DD HH:MM:SS.uuuuuu"
+#define TIME_TEXT_MAX (TIME_TEXT_LENGTH + 7)
+// Characters of a formatted delta such as "+123.456 ms", with the terminator
+#define TIME_DELTA_SIZE 32
+// Characters of the "YYYY-MM-DD HH:MM:" prefix shared by a minute
+#define TIME_PREFIX_LENGTH 17
+// Minutes and rows remembered, both direct mapped
+#define TIME_CACHE_MINUTES 64
+#define TIME_CACHE_ROWS 256
+
+//********************************************************************************************
+typedef enum time_precision_e
+{
+    TIME_SECONDS,
+    TIME_MILLISECONDS,
+    TIME_MICROSECONDS
+} time_precision_e;
+//********************************************************************************************
+typedef struct time_minute_t
+{
+    i64 minute = -1;                        // timestamp in minutes the prefix belongs to
+    char prefix[TIME_PREFIX_LENGTH];
+} time_minute_t;
+//********************************************************************************************
+typedef struct time_row_t
+{
+    u64 id = ~0ull;
+    u64 timestamp = 0;
+    i64 delta = 0;                          // to the row above, depends on the view
+    bool has_delta = false;
+    char text[TIME_TEXT_MAX + 1];
+    char delta_text[TIME_DELTA_SIZE];
+} time_row_t;
+//********************************************************************************************
+// Formats nanosecond timestamps as local time. Only the first timestamp of a minute goes
+// through localtime and strftime, the others copy its prefix and append the seconds and
+// the fraction the precision asks for. Rows that stay on screen are not formatted again.
+typedef struct time_format_cache_t
+{
+    time_precision_e precision = TIME_SECONDS;
+    time_minute_t minutes[TIME_CACHE_MINUTES];
+    time_row_t rows[TIME_CACHE_ROWS];
+    char delta_text[TIME_DELTA_SIZE];       // deltas of rows that are not remembered
+} time_format_cache_t;
+//********************************************************************************************
+void time_format_set_precision(time_format_cache_t& cache, time_precision_e precision);
+// Writes up to TIME_TEXT_MAX characters and a terminator to text
+void time_format(time_format_cache_t& cache, u64 timestamp, char* text);
+// Formatted timestamp of the log entry id, valid until the next call
+const char* time_format_row(time_format_cache_t& cache, u64 id, u64 timestamp);
+// Formatted delta of the log entry id to the row above it, kept with the row's timestamp
+// so it is only formatted again when the view puts another row above it. Call after
+// time_format_row for the same id.
+const char* time_format_row_delta(time_format_cache_t& cache, u64 id, i64 delta);
+// Signed difference of two nanosecond timestamps in the largest unit below it,
+// writes at most TIME_DELTA_SIZE characters including the terminator
+void time_format_delta(i64 delta, char* text);
+//********************************************************************************************
+
+#endif // TIME_FORMAT_H
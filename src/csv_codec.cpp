@@ -0,0 +1,150 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#include <string.h>
+// INTERNAL INCLUDES
+#include "csv_codec.h"
+#include "text_scan.h"
+
+//********************************************************************************************
+bool csv_writer_open(csv_writer_t& writer, const char* filename)
+{
+    // Binary mode, line breaks inside quoted fields must reach the file unchanged
+    writer.file = fopen(filename, "wb");
+    if (!writer.file)
+        return false;
+    writer.buffer.reset(new char[CSV_WRITE_BUFFER]);
+    writer.used = 0;
+    writer.failed = false;
+    return true;
+}
+//********************************************************************************************
+bool csv_writer_close(csv_writer_t& writer)
+{
+    if (!writer.file)
+        return false;
+    csv_writer_flush(writer);
+    if (fclose(writer.file) != 0)
+        writer.failed = true;
+    writer.file = NULL;
+    writer.buffer.reset();
+    return !writer.failed;
+}
+//********************************************************************************************
+void csv_writer_flush(csv_writer_t& writer)
+{
+    if (writer.used > 0 && fwrite(writer.buffer.get(), 1, writer.used, writer.file) != writer.used)
+        writer.failed = true;
+    writer.used = 0;
+}
+//********************************************************************************************
+void csv_write_raw(csv_writer_t& writer, const char* data, size_t length)
+{
+    while (length > 0)
+    {
+        if (writer.used == CSV_WRITE_BUFFER)
+            csv_writer_flush(writer);
+        size_t n = CSV_WRITE_BUFFER - writer.used;
+        if (n > length)
+            n = length;
+        memcpy(writer.buffer.get() + writer.used, data, n);
+        writer.used += n;
+        data += n;
+        length -= n;
+    }
+}
+//********************************************************************************************
+void csv_write_field(csv_writer_t& writer, const char* data, size_t length)
+{
+    const char* end = data + length;
+    const char* special = scan_find_any(data, end, ',', '"', '\n', '\r');
+    if (special == end)
+    {
+        csv_write_raw(writer, data, length); // nothing to escape
+        return;
+    }
+
+    // Quote the field and double every quote inside it
+    csv_write_raw(writer, "\"", 1);
+    const char* p = data;
+    for (const char* quote = scan_find(special, end, '"'); quote < end; quote = scan_find(p, end, '"'))
+    {
+        csv_write_raw(writer, p, quote + 1 - p);
+        csv_write_raw(writer, "\"", 1);
+        p = quote + 1;
+    }
+    csv_write_raw(writer, p, end - p);
+    csv_write_raw(writer, "\"", 1);
+}
+//********************************************************************************************
+void csv_write_u64(csv_writer_t& writer, u64 value)
+{
+    char digits[20];
+    char* p = digits + sizeof(digits);
+    do
+    {
+        *--p = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    csv_write_raw(writer, p, digits + sizeof(digits) - p);
+}
+//********************************************************************************************
+void csv_write_timestamp(csv_writer_t& writer, u64 timestamp)
+{
+    csv_write_u64(writer, timestamp / 1000000000);
+
+    char fraction[10];
+    u64 value = timestamp % 1000000000;
+    fraction[0] = '.';
+    for (int i = 9; i > 0; --i)
+    {
+        fraction[i] = (char)('0' + value % 10);
+        value /= 10;
+    }
+    csv_write_raw(writer, fraction, sizeof(fraction));
+}
+//********************************************************************************************
+void csv_end_row(csv_writer_t& writer)
+{
+    csv_write_raw(writer, "\r\n", 2);
+}
+//********************************************************************************************
+u32 csv_unescape(char* dst, const char* src, size_t length)
+{
+    const char* end = src + length;
+    char* out = dst;
+    while (src < end)
+    {
+        const char* quote = scan_find(src, end, '"');
+        size_t n = quote - src;
+        memmove(out, src, n);
+        out += n;
+        if (quote == end)
+            break;
+        *out++ = '"';
+        src = quote + 1;
+        if (src < end && *src == '"')
+            src++; // skip the escaping half of the pair
+    }
+    return (u32)(out - dst);
+}
+//********************************************************************************************
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+ // EXTERNAL INCLUDES
+#include <new>
+#include <stdlib.h>
+// INTERNAL INCLUDES
+#include "debug_alloc.h"
+
+#if DEBUG_ALLOC_COUNT
+static thread_local u64 allocations = 0;
+
+//********************************************************************************************
+u64 debug_alloc_count(void)
+{
+    return allocations;
+}
+//********************************************************************************************
+// Replaces the global allocator for the whole program, the array forms forward here
+void* operator new(size_t size)
+{
+    allocations++;
+    void* p = malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+//********************************************************************************************
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+//********************************************************************************************
+void operator delete(void* p, size_t) noexcept
+{
+    free(p);
+}
+//********************************************************************************************
+#endif
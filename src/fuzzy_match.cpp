@@ -0,0 +1,84 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#include <string.h>
+// INTERNAL INCLUDES
+#include "fuzzy_match.h"
+
+//********************************************************************************************
+void fuzzy_pattern_init(fuzzy_pattern_t& pattern, const char* text, size_t length, u32 max_edits, bool ignore_case)
+{
+    if (length > FUZZY_MAX_LENGTH)
+        length = FUZZY_MAX_LENGTH;
+    if (max_edits > FUZZY_MAX_EDITS)
+        max_edits = FUZZY_MAX_EDITS;
+
+    memset(pattern.masks, 0, sizeof(pattern.masks));
+    pattern.length = (u32)length;
+    pattern.max_edits = max_edits;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        const u8 c = (u8)text[i];
+        pattern.masks[c] |= (u64)1 << i;
+        if (ignore_case && c >= 'a' && c <= 'z')
+            pattern.masks[c - ('a' - 'A')] |= (u64)1 << i;
+        else if (ignore_case && c >= 'A' && c <= 'Z')
+            pattern.masks[c + ('a' - 'A')] |= (u64)1 << i;
+    }
+}
+//********************************************************************************************
+bool fuzzy_find(const fuzzy_pattern_t& pattern, const char* text, size_t length)
+{
+    const u32 edits = pattern.max_edits;
+    if (pattern.length <= edits)
+        return true;
+
+    // Before any text the first d pattern bytes can only be deleted
+    u64 states[FUZZY_MAX_EDITS + 1];
+    for (u32 d = 0; d <= edits; ++d)
+        states[d] = ((u64)1 << d) - 1;
+
+    const u64 accept = (u64)1 << (pattern.length - 1);
+    const u8* bytes = (const u8*)text;
+    for (size_t i = 0; i < length; ++i)
+    {
+        const u64 mask = pattern.masks[bytes[i]];
+        u64 previous = states[0];   // states[d - 1] before this byte
+        states[0] = ((states[0] << 1) | 1) & mask;
+
+        for (u32 d = 1; d <= edits; ++d)
+        {
+            const u64 current = states[d];
+            states[d] = (((current << 1) | 1) & mask)  // match
+                | previous                             // insertion of the text byte
+                | (previous << 1) | 1                  // substitution
+                | (states[d - 1] << 1);                // deletion of a pattern byte
+            previous = current;
+        }
+
+        if (states[edits] & accept)
+            return true;
+    }
+    return false;
+}
+//********************************************************************************************
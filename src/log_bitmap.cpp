@@ -0,0 +1,99 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#include <stddef.h>
+// INTERNAL INCLUDES
+#include "log_bitmap.h"
+
+//********************************************************************************************
+void log_bitmap_add(log_bitmap_t& bitmap, u16 row)
+{
+    if (bitmap.words.empty())
+    {
+        if (bitmap.cardinality < LOG_BITMAP_ARRAY_MAX)
+        {
+            bitmap.rows.push_back(row);
+            bitmap.cardinality++;
+            return;
+        }
+
+        // Too many rows for the array, from now on a bit per row takes less space
+        bitmap.words.assign(LOG_BITMAP_WORDS, 0);
+        for (size_t i = 0; i < bitmap.rows.size(); ++i)
+            bitmap.words[bitmap.rows[i] >> 6] |= (u64)1 << (bitmap.rows[i] & 63);
+        bitmap.rows.clear();
+        bitmap.rows.shrink_to_fit();
+    }
+
+    bitmap.words[row >> 6] |= (u64)1 << (row & 63);
+    bitmap.cardinality++;
+}
+//********************************************************************************************
+void log_bitmap_or(const log_bitmap_t& bitmap, u64* words)
+{
+    if (!bitmap.words.empty())
+    {
+        for (u32 w = 0; w < LOG_BITMAP_WORDS; ++w)
+            words[w] |= bitmap.words[w];
+        return;
+    }
+
+    for (size_t i = 0; i < bitmap.rows.size(); ++i)
+        words[bitmap.rows[i] >> 6] |= (u64)1 << (bitmap.rows[i] & 63);
+}
+//********************************************************************************************
+void log_bitmap_andnot(const log_bitmap_t& bitmap, u64* words)
+{
+    if (!bitmap.words.empty())
+    {
+        for (u32 w = 0; w < LOG_BITMAP_WORDS; ++w)
+            words[w] &= ~bitmap.words[w];
+        return;
+    }
+
+    for (size_t i = 0; i < bitmap.rows.size(); ++i)
+        words[bitmap.rows[i] >> 6] &= ~((u64)1 << (bitmap.rows[i] & 63));
+}
+//********************************************************************************************
+void log_bitmap_set_add(log_bitmap_set_t& set, u16 value, u16 row)
+{
+    if (set.slots.size() <= value)
+        set.slots.resize((size_t)value + 1, 0);
+
+    u32 slot = set.slots[value];
+    if (slot == 0)
+    {
+        set.values.push_back(value);
+        set.bitmaps.emplace_back();
+        slot = (u32)set.bitmaps.size();
+        set.slots[value] = slot;
+    }
+    log_bitmap_add(set.bitmaps[slot - 1], row);
+}
+//********************************************************************************************
+void log_bitmap_set_clear(log_bitmap_set_t& set)
+{
+    set.slots.clear();
+    set.values.clear();
+    set.bitmaps.clear();
+}
+//********************************************************************************************
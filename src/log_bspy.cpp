@@ -0,0 +1,339 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+// INTERNAL INCLUDES
+#include "log_bspy.h"
+#include "lz_block.h"
+#include "mapped_file.h"
+
+static_assert(sizeof(bspy_file_header_t) == 16, "bspy file header layout");
+static_assert(sizeof(bspy_block_header_t) == 32, "bspy block header layout");
+static_assert(sizeof(bspy_index_entry_t) == 40, "bspy index entry layout");
+static_assert(sizeof(bspy_trailer_t) == 32, "bspy trailer layout");
+
+static const char padding[8] = {};
+
+//********************************************************************************************
+static size_t pad8(size_t size)
+{
+    return (size + 7) & ~(size_t)7;
+}
+//********************************************************************************************
+// Rows collected for the block being written
+typedef struct bspy_block_builder_t
+{
+    std::vector<u64> timestamps;
+    std::vector<u32> content_lengths;
+    std::vector<u16> origins;
+    std::vector<u8> severities;
+    std::vector<char> text;
+    u64 min_timestamp;
+    u64 max_timestamp;
+} bspy_block_builder_t;
+//********************************************************************************************
+typedef struct bspy_writer_t
+{
+    FILE* file;
+    u64 offset;
+    bool failed;
+    std::vector<char> payload;
+    std::vector<char> packed;
+    std::vector<bspy_index_entry_t> index;
+} bspy_writer_t;
+//********************************************************************************************
+static void write_bytes(bspy_writer_t& writer, const void* data, size_t size)
+{
+    if (size > 0 && fwrite(data, 1, size, writer.file) != size)
+        writer.failed = true;
+    writer.offset += size;
+}
+//********************************************************************************************
+template <typename T>
+static void append_column(std::vector<char>& payload, const std::vector<T>& column)
+{
+    size_t at = payload.size();
+    size_t size = column.size() * sizeof(T);
+    payload.resize(at + pad8(size), 0);
+    if (size > 0)
+        memcpy(payload.data() + at, column.data(), size);
+}
+//********************************************************************************************
+static void flush_block(bspy_writer_t& writer, bspy_block_builder_t& block)
+{
+    if (block.timestamps.empty())
+        return;
+
+    bspy_index_entry_t entry = {};
+    entry.offset = writer.offset;
+    entry.header.min_timestamp = block.min_timestamp;
+    entry.header.max_timestamp = block.max_timestamp;
+    entry.header.count = (u32)block.timestamps.size();
+    entry.header.content_bytes = (u32)block.text.size();
+    for (size_t i = 0; i < block.severities.size(); ++i)
+        entry.header.severity_mask |= (u8)(1u << block.severities[i]);
+
+    // Timestamps relative to the block minimum, the high bytes are mostly zero and compress
+    std::vector<u64> offsets(block.timestamps.size());
+    for (size_t i = 0; i < offsets.size(); ++i)
+        offsets[i] = block.timestamps[i] - block.min_timestamp;
+
+    writer.payload.clear();
+    append_column(writer.payload, offsets);
+    append_column(writer.payload, block.content_lengths);
+    append_column(writer.payload, block.origins);
+    append_column(writer.payload, block.severities);
+    append_column(writer.payload, block.text);
+
+    // Keep the compressed form only when it actually saves space
+    const char* payload = writer.payload.data();
+    size_t payload_bytes = writer.payload.size();
+    writer.packed.resize(lz_compress_bound(payload_bytes));
+    size_t packed_bytes = lz_compress(payload, payload_bytes, writer.packed.data(), writer.packed.size());
+    if (packed_bytes > 0 && packed_bytes < payload_bytes)
+    {
+        payload = writer.packed.data();
+        payload_bytes = packed_bytes;
+        entry.header.compression = BSPY_COMPRESSION_LZ;
+    }
+    entry.header.payload_bytes = (u32)payload_bytes;
+
+    write_bytes(writer, &entry.header, sizeof(entry.header));
+    write_bytes(writer, payload, payload_bytes);
+    write_bytes(writer, padding, pad8(payload_bytes) - payload_bytes);
+    writer.index.push_back(entry);
+
+    block.timestamps.clear();
+    block.content_lengths.clear();
+    block.origins.clear();
+    block.severities.clear();
+    block.text.clear();
+}
+//********************************************************************************************
+bool save_logs_to_bspy(const char* filename, const log_snapshot_t& snapshot, log_progress_t* progress)
+{
+    const std::string temp = file_temp_name(filename);
+    bspy_writer_t writer;
+    writer.file = fopen(temp.c_str(), "wb");
+    if (!writer.file)
+        return false;
+    writer.offset = 0;
+    writer.failed = false;
+
+    bspy_file_header_t header = {};
+    memcpy(header.magic, BSPY_MAGIC, sizeof(header.magic));
+    header.version = BSPY_VERSION;
+    write_bytes(writer, &header, sizeof(header));
+
+    bspy_block_builder_t block;
+    block.min_timestamp = block.max_timestamp = 0;
+    log_snapshot_cursor_t cursor;
+    log_snapshot_cursor_init(cursor, snapshot);
+    const log_segment_t* segment;
+    u32 i;
+    u64 rows = 0;
+    while (log_snapshot_next(cursor, segment, i))
+    {
+        u64 timestamp = segment->timestamps[i];
+        u32 length = segment->content_lengths[i];
+
+        if (!block.timestamps.empty() &&
+            (block.timestamps.size() >= BSPY_BLOCK_ROWS ||
+            block.text.size() >= BSPY_BLOCK_TEXT ||
+            block.text.size() + length > 0xFFFFFFFFu))
+        {
+            flush_block(writer, block);
+        }
+        if (block.timestamps.empty())
+            block.min_timestamp = block.max_timestamp = timestamp;
+        else if (timestamp < block.min_timestamp)
+            block.min_timestamp = timestamp;
+        else if (timestamp > block.max_timestamp)
+            block.max_timestamp = timestamp;
+
+        const char* content = cursor.text + segment->content_offsets[i];
+        block.timestamps.push_back(timestamp);
+        block.content_lengths.push_back(length);
+        block.origins.push_back(segment->origins[i]);
+        block.severities.push_back(segment->severities[i]);
+        block.text.insert(block.text.end(), content, content + length);
+
+        if ((++rows & (LOG_PROGRESS_STEP - 1)) == 0 && !log_progress_step(progress, LOG_PROGRESS_STEP))
+        {
+            fclose(writer.file);
+            file_commit(temp.c_str(), filename, false);
+            return false;
+        }
+    }
+    log_progress_step(progress, rows & (LOG_PROGRESS_STEP - 1));
+    flush_block(writer, block);
+
+    // Origin table, ids in the blocks are store ids so the names are written as they are
+    bspy_trailer_t trailer = {};
+    trailer.origins_offset = writer.offset;
+    trailer.origin_count = (u32)snapshot.origin_names.size();
+    for (size_t i = 0; i < snapshot.origin_names.size(); ++i)
+    {
+        // Names are cut to LOG_ORIGIN_MAX_LENGTH when interned
+        const std::string& name = snapshot.origin_names[i];
+        u16 length = (u16)name.length();
+        write_bytes(writer, &length, sizeof(length));
+        write_bytes(writer, name.data(), length);
+    }
+    write_bytes(writer, padding, pad8(writer.offset) - writer.offset);
+
+    trailer.index_offset = writer.offset;
+    trailer.block_count = (u32)writer.index.size();
+    write_bytes(writer, writer.index.data(), writer.index.size() * sizeof(bspy_index_entry_t));
+
+    memcpy(trailer.magic, BSPY_MAGIC, sizeof(trailer.magic));
+    write_bytes(writer, &trailer, sizeof(trailer));
+
+    if (fclose(writer.file) != 0)
+        writer.failed = true;
+    return file_commit(temp.c_str(), filename, !writer.failed);
+}
+//********************************************************************************************
+bool load_logs_from_bspy(const char* filename, log_store_t& logs)
+{
+    std::shared_ptr<mapped_file_t> file = mapped_file_open(filename);
+    if (!file || !file->data || file->size < sizeof(bspy_file_header_t) + sizeof(bspy_trailer_t))
+        return false;
+
+    const char* data = file->data;
+    const u64 size = file->size;
+
+    bspy_file_header_t header;
+    bspy_trailer_t trailer;
+    memcpy(&header, data, sizeof(header));
+    memcpy(&trailer, data + size - sizeof(trailer), sizeof(trailer));
+    if (memcmp(header.magic, BSPY_MAGIC, sizeof(header.magic)) != 0 ||
+        memcmp(trailer.magic, BSPY_MAGIC, sizeof(trailer.magic)) != 0 ||
+        header.version != BSPY_VERSION)
+    {
+        return false;
+    }
+
+    const u64 index_end = size - sizeof(trailer);
+    if (trailer.origins_offset > trailer.index_offset ||
+        trailer.index_offset > index_end ||
+        trailer.index_offset % 8 != 0 ||
+        (index_end - trailer.index_offset) / sizeof(bspy_index_entry_t) < trailer.block_count)
+    {
+        return false;
+    }
+
+    // Fill a separate store and take it over once every block validated, a corrupt block
+    // must not leave a partially loaded capture behind
+    log_store_t loaded;
+    loaded.retention = logs.retention;
+
+    // Map file origin ids to store ids
+    std::vector<u16> origins(trailer.origin_count);
+    const char* p = data + trailer.origins_offset;
+    const char* origins_end = data + trailer.index_offset;
+    for (u32 i = 0; i < trailer.origin_count; ++i)
+    {
+        u16 length;
+        if (origins_end - p < (ptrdiff_t)sizeof(length))
+            return false;
+        memcpy(&length, p, sizeof(length));
+        p += sizeof(length);
+        if (origins_end - p < length)
+            return false;
+        origins[i] = log_store_intern_origin(loaded, p, length);
+        p += length;
+    }
+
+    // Uncompressed blocks are used straight from the mapping. Compressed ones are unpacked
+    // and their content copied into the store, where it can be packed again once cold.
+    std::shared_ptr<const void> source = file;
+    const bspy_index_entry_t* index = (const bspy_index_entry_t*)(data + trailer.index_offset);
+    std::vector<char> unpacked;
+    for (u32 b = 0; b < trailer.block_count; ++b)
+    {
+        const bspy_block_header_t& block = index[b].header;
+        const u64 offset = index[b].offset + sizeof(bspy_block_header_t);
+        const u64 column_bytes = pad8(block.count * sizeof(u64)) + pad8(block.count * sizeof(u32)) +
+            pad8(block.count * sizeof(u16)) + pad8(block.count);
+        const u64 raw_bytes = column_bytes + pad8(block.content_bytes);
+        if (offset % 8 != 0 ||
+            offset > trailer.origins_offset ||
+            block.payload_bytes > trailer.origins_offset - offset)
+        {
+            return false;
+        }
+
+        const char* payload = data + offset;
+        if (block.compression == BSPY_COMPRESSION_LZ)
+        {
+            unpacked.resize(raw_bytes);
+            if (!lz_decompress(payload, block.payload_bytes, unpacked.data(), raw_bytes))
+                return false;
+            payload = unpacked.data();
+        }
+        else if (block.compression != BSPY_COMPRESSION_NONE || raw_bytes > block.payload_bytes)
+        {
+            return false;
+        }
+
+        const char* column = payload;
+        const u64* timestamps = (const u64*)column;
+        column += pad8(block.count * sizeof(u64));
+        const u32* lengths = (const u32*)column;
+        column += pad8(block.count * sizeof(u32));
+        const u16* origin_ids = (const u16*)column;
+        column += pad8(block.count * sizeof(u16));
+        const u8* severities = (const u8*)column;
+        column += pad8(block.count);
+        const char* text = column;
+        const char* text_end = text + block.content_bytes;
+        for (u32 i = 0; i < block.count; ++i)
+        {
+            if ((u64)(text_end - text) < lengths[i])
+                return false;
+
+            if (origin_ids[i] >= origins.size() || severities[i] > TRCE)
+                return false;
+
+            u64 timestamp = block.min_timestamp + timestamps[i];
+            if (block.compression == BSPY_COMPRESSION_LZ)
+            {
+                log_store_append_interned(loaded, timestamp, (log_severity_e)severities[i],
+                    origins[origin_ids[i]], text, lengths[i]);
+            }
+            else
+            {
+                log_store_append_external(loaded, source, timestamp, (log_severity_e)severities[i],
+                    origins[origin_ids[i]], text, lengths[i]);
+            }
+            text += lengths[i];
+        }
+    }
+
+    log_store_replace(logs, loaded);
+    return true;
+}
+//********************************************************************************************
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#include <algorithm>
+#include <thread>
+// INTERNAL INCLUDES
+#include "log_export.h"
+#include "log_file.h"
+
+//********************************************************************************************
+static void export_main(log_export_t* exporter)
+{
+    exporter->succeeded = save_logs_to_file(exporter->filename.c_str(), exporter->snapshot, &exporter->progress);
+
+    // Let go of the segments so the store can compact and reuse them again
+    exporter->snapshot.segments.clear();
+    exporter->snapshot.origin_names.clear();
+    exporter->snapshot.ids.clear();
+    exporter->finished.store(true, std::memory_order_release);
+    if (exporter->notify)
+        exporter->notify(exporter->notify_user);
+}
+//********************************************************************************************
+bool log_export_start(log_export_t& exporter, log_store_t& store, const std::deque<u64>* ids, const char* filename)
+{
+    if (log_export_busy(exporter))
+        return false;
+
+    // A filtered export only copies the matching ids, its cost follows the match count
+    log_store_snapshot(store, exporter.snapshot);
+    exporter.total = exporter.snapshot.next_id - exporter.snapshot.first_id;
+    if (ids)
+    {
+        exporter.snapshot.filtered = true;
+        std::deque<u64>::const_iterator first = std::lower_bound(ids->begin(), ids->end(), exporter.snapshot.first_id);
+        exporter.snapshot.ids.assign(first, ids->end());
+        exporter.total = exporter.snapshot.ids.size();
+    }
+    exporter.filename = filename;
+    exporter.progress.rows = 0;
+    exporter.progress.cancel = false;
+    exporter.finished = false;
+    exporter.succeeded = false;
+    exporter.thread = std::thread(export_main, &exporter);
+    return true;
+}
+//********************************************************************************************
+bool log_export_busy(const log_export_t& exporter)
+{
+    return exporter.thread.joinable();
+}
+//********************************************************************************************
+bool log_export_poll(log_export_t& exporter, bool& succeeded)
+{
+    if (!exporter.thread.joinable() || !exporter.finished.load(std::memory_order_acquire))
+        return false;
+
+    exporter.thread.join();
+    succeeded = exporter.succeeded;
+    return true;
+}
+//********************************************************************************************
+void log_export_cancel(log_export_t& exporter)
+{
+    if (!exporter.thread.joinable())
+        return;
+
+    exporter.progress.cancel = true;
+    exporter.thread.join();
+}
+//********************************************************************************************
+float log_export_fraction(const log_export_t& exporter)
+{
+    if (exporter.total == 0)
+        return 1.0f;
+    u64 rows = exporter.progress.rows.load(std::memory_order_relaxed);
+    return rows >= exporter.total ? 1.0f : (float)((double)rows / (double)exporter.total);
+}
+//********************************************************************************************
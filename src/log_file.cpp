@@ -0,0 +1,406 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#include <stdio.h>
+#include <string.h>
+#include <string>
+// INTERNAL INCLUDES
+#include "csv_codec.h"
+#include "log_bspy.h"
+#include "log_file.h"
+#include "log_parser.h"
+#include "mapped_file.h"
+#include "text_scan.h"
+#include "thread_pool.h"
+
+#define CSV_HEADER "Timestamp,Severity,Origin,Content"
+// Smallest byte range worth handing to a worker
+#define LOAD_CHUNK_MIN (4 * 1024 * 1024)
+
+#define write_literal(writer, text) csv_write_raw(writer, text, sizeof(text) - 1)
+
+//********************************************************************************************
+bool save_logs_to_csv(const char* filename, const log_snapshot_t& snapshot, log_progress_t* progress)
+{
+    const std::string temp = file_temp_name(filename);
+    csv_writer_t writer;
+    if (!csv_writer_open(writer, temp.c_str()))
+        return false;
+
+    // Write CSV header
+    csv_write_raw(writer, CSV_HEADER, strlen(CSV_HEADER));
+    csv_end_row(writer);
+
+    log_snapshot_cursor_t cursor;
+    log_snapshot_cursor_init(cursor, snapshot);
+    const log_segment_t* segment;
+    u32 i;
+    u64 rows = 0;
+    while (log_snapshot_next(cursor, segment, i))
+    {
+        const char* severity = severity_to_string((log_severity_e)segment->severities[i]);
+        const std::string& origin = snapshot.origin_names[segment->origins[i]];
+
+        csv_write_timestamp(writer, segment->timestamps[i]);
+        csv_write_separator(writer);
+        csv_write_raw(writer, severity, strlen(severity));
+        csv_write_separator(writer);
+        csv_write_field(writer, origin.data(), origin.length());
+        csv_write_separator(writer);
+        csv_write_field(writer, cursor.text + segment->content_offsets[i], segment->content_lengths[i]);
+        csv_end_row(writer);
+
+        if ((++rows & (LOG_PROGRESS_STEP - 1)) == 0 && !log_progress_step(progress, LOG_PROGRESS_STEP))
+        {
+            csv_writer_close(writer);
+            file_commit(temp.c_str(), filename, false);
+            return false;
+        }
+    }
+    log_progress_step(progress, rows & (LOG_PROGRESS_STEP - 1));
+
+    return file_commit(temp.c_str(), filename, csv_writer_close(writer));
+}
+//********************************************************************************************
+// Length of the well formed UTF-8 sequence starting with a non ASCII byte at p, or 0.
+// Overlong forms, surrogates and code points above U+10FFFF are not well formed.
+static size_t utf8_sequence_length(const u8* p, const u8* end)
+{
+    size_t length;
+    u8 lo = 0x80;
+    u8 hi = 0xBF;
+    if (p[0] >= 0xC2 && p[0] <= 0xDF)
+        length = 2;
+    else if (p[0] >= 0xE0 && p[0] <= 0xEF)
+        length = 3;
+    else if (p[0] >= 0xF0 && p[0] <= 0xF4)
+        length = 4;
+    else
+        return 0;
+
+    // Bounds of the second byte that rule out the invalid ranges
+    if (p[0] == 0xE0)
+        lo = 0xA0;
+    else if (p[0] == 0xED)
+        hi = 0x9F;
+    else if (p[0] == 0xF0)
+        lo = 0x90;
+    else if (p[0] == 0xF4)
+        hi = 0x8F;
+
+    if ((size_t)(end - p) < length || p[1] < lo || p[1] > hi)
+        return 0;
+    for (size_t i = 2; i < length; ++i)
+    {
+        if ((p[i] & 0xC0) != 0x80)
+            return 0;
+    }
+    return length;
+}
+//********************************************************************************************
+static void write_json_string(csv_writer_t& writer, const char* data, size_t length)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    csv_write_raw(writer, "\"", 1);
+
+    // Copy runs that need no escaping in one go. Bytes that are not valid UTF-8 become
+    // U+FFFD, JSON readers refuse them otherwise.
+    const char* end = data + length;
+    const char* run = data;
+    for (const char* p = data; p < end; ++p)
+    {
+        u8 c = (u8)*p;
+        if (c >= 0x80)
+        {
+            size_t sequence = utf8_sequence_length((const u8*)p, (const u8*)end);
+            if (sequence)
+            {
+                p += sequence - 1;
+                continue;
+            }
+            csv_write_raw(writer, run, p - run);
+            write_literal(writer, "\\ufffd");
+            run = p + 1;
+            continue;
+        }
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+
+        csv_write_raw(writer, run, p - run);
+        run = p + 1;
+        switch (c)
+        {
+        case '"': csv_write_raw(writer, "\\\"", 2); break;
+        case '\\': csv_write_raw(writer, "\\\\", 2); break;
+        case '\n': csv_write_raw(writer, "\\n", 2); break;
+        case '\r': csv_write_raw(writer, "\\r", 2); break;
+        case '\t': csv_write_raw(writer, "\\t", 2); break;
+        default:
+        {
+            char escape[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 15] };
+            csv_write_raw(writer, escape, sizeof(escape));
+            break;
+        }
+        }
+    }
+    csv_write_raw(writer, run, end - run);
+    csv_write_raw(writer, "\"", 1);
+}
+//********************************************************************************************
+bool save_logs_to_jsonl(const char* filename, const log_snapshot_t& snapshot, log_progress_t* progress)
+{
+    const std::string temp = file_temp_name(filename);
+    csv_writer_t writer;
+    if (!csv_writer_open(writer, temp.c_str()))
+        return false;
+
+    // One object per line: {"timestamp":..,"severity":"..","origin":"..","content":".."}
+    // with the timestamp as integer nanoseconds since the Unix epoch
+    log_snapshot_cursor_t cursor;
+    log_snapshot_cursor_init(cursor, snapshot);
+    const log_segment_t* segment;
+    u32 i;
+    u64 rows = 0;
+    while (log_snapshot_next(cursor, segment, i))
+    {
+        const char* severity = severity_to_string((log_severity_e)segment->severities[i]);
+        const std::string& origin = snapshot.origin_names[segment->origins[i]];
+
+        write_literal(writer, "{\"timestamp\":");
+        csv_write_u64(writer, segment->timestamps[i]);
+        write_literal(writer, ",\"severity\":\"");
+        csv_write_raw(writer, severity, strlen(severity));
+        write_literal(writer, "\",\"origin\":");
+        write_json_string(writer, origin.data(), origin.length());
+        write_literal(writer, ",\"content\":");
+        write_json_string(writer, cursor.text + segment->content_offsets[i], segment->content_lengths[i]);
+        csv_write_raw(writer, "}\n", 2);
+
+        if ((++rows & (LOG_PROGRESS_STEP - 1)) == 0 && !log_progress_step(progress, LOG_PROGRESS_STEP))
+        {
+            csv_writer_close(writer);
+            file_commit(temp.c_str(), filename, false);
+            return false;
+        }
+    }
+    log_progress_step(progress, rows & (LOG_PROGRESS_STEP - 1));
+
+    return file_commit(temp.c_str(), filename, csv_writer_close(writer));
+}
+//********************************************************************************************
+// Byte range of the file parsed by one worker. Records starting in [begin, end) belong
+// to the chunk, the last one may run past end.
+typedef struct csv_chunk_t
+{
+    const char* begin;
+    const char* end;
+    const char* parsed_end;     // start of the first record not taken by this chunk
+    log_store_t origins;        // chunk local origin ids, remapped when merging
+    std::vector<u64> timestamps;
+    std::vector<u8> severities;
+    std::vector<u16> origin_ids;
+    std::vector<const char*> contents;
+    std::vector<u32> content_lengths;
+    std::vector<u32> escaped_rows;  // content still holding doubled quotes
+} csv_chunk_t;
+//********************************************************************************************
+static const char* find_record_start(const char* p, const char* data, const char* end)
+{
+    // Guess only, a line inside multi-line quoted content can look like a record too.
+    // Chunks that guessed wrong are detected and reparsed while merging.
+    while (p < end)
+    {
+        if ((p == data || p[-1] == '\n') && log_looks_like_record(p, end))
+            return p;
+        p = scan_find(p, end, '\n');
+        if (p < end)
+            p++;
+    }
+    return end;
+}
+//********************************************************************************************
+static void parse_chunk(csv_chunk_t& chunk, const char* file_end)
+{
+    // A reparse must not keep origins the misaligned pass interned, the merge would add them
+    log_store_clear(chunk.origins);
+    chunk.timestamps.clear();
+    chunk.severities.clear();
+    chunk.origin_ids.clear();
+    chunk.contents.clear();
+    chunk.content_lengths.clear();
+    chunk.escaped_rows.clear();
+
+    std::string origin;
+    const char* p = chunk.begin;
+    while (p < chunk.end)
+    {
+        log_record_t record;
+        bool valid;
+        p = log_parse_line(p, file_end, record, valid);
+        if (valid)
+        {
+            if (record.origin_escaped)
+            {
+                origin.resize(record.origin_length);
+                origin.resize(csv_unescape(&origin[0], record.origin, record.origin_length));
+                record.origin = origin.data();
+                record.origin_length = (u32)origin.length();
+            }
+            if (record.content_escaped)
+                chunk.escaped_rows.push_back((u32)chunk.contents.size());
+
+            chunk.timestamps.push_back(record.timestamp);
+            chunk.severities.push_back((u8)record.severity);
+            chunk.origin_ids.push_back(log_store_intern_origin(chunk.origins, record.origin, record.origin_length));
+            chunk.contents.push_back(record.content);
+            chunk.content_lengths.push_back(record.content_length);
+        }
+    }
+    chunk.parsed_end = p;
+}
+//********************************************************************************************
+bool load_logs_from_csv(const char* filename, log_store_t& logs)
+{
+    // Map the whole file, entries point straight into the mapping instead of being copied
+    std::shared_ptr<mapped_file_t> file = mapped_file_open(filename);
+    if (!file || !file->data)
+        return false;
+
+    const char* p = file->data;
+    const char* end = p + file->size;
+
+    // Check for: [Timestamp,Severity,Origin,Content]
+    const char* header_end = scan_find(p, end, '\n');
+    const char* data = header_end < end ? header_end + 1 : end;
+    if (header_end > p && header_end[-1] == '\r')
+        header_end--;
+    if ((size_t)(header_end - p) != strlen(CSV_HEADER) || memcmp(p, CSV_HEADER, strlen(CSV_HEADER)) != 0)
+        return false;
+
+    log_store_clear(logs); // clear existing logs
+
+    // Split into record aligned byte ranges and parse them on all cores
+    thread_pool_t& pool = thread_pool_shared();
+    const size_t size = end - data;
+    size_t chunk_count = size / LOAD_CHUNK_MIN;
+    const size_t max_chunks = (pool.workers.size() + 1) * 4;
+    if (chunk_count > max_chunks)
+        chunk_count = max_chunks;
+    if (chunk_count == 0)
+        chunk_count = 1;
+
+    std::vector<csv_chunk_t> chunks(chunk_count);
+    for (size_t i = 0; i < chunk_count; ++i)
+    {
+        const char* nominal = data + size / chunk_count * i;
+        chunks[i].begin = i == 0 ? data : find_record_start(nominal, data, end);
+    }
+    for (size_t i = 0; i < chunk_count; ++i)
+        chunks[i].end = i + 1 < chunk_count ? chunks[i + 1].begin : end;
+
+    thread_pool_parallel_for(pool, (u32)chunk_count, [&](u32 i) {
+        parse_chunk(chunks[i], end);
+    });
+
+    // Merge in file order. resume is where the records taken so far really end, a chunk
+    // that did not start there began inside quoted content and is parsed again from it.
+    // A record may run over whole chunks, those stay empty.
+    std::shared_ptr<const void> source = file;
+    std::vector<u16> remap;
+    const char* resume = data;
+    for (size_t i = 0; i < chunk_count; ++i)
+    {
+        csv_chunk_t& chunk = chunks[i];
+        if (chunk.begin != resume)
+        {
+            chunk.begin = resume < chunk.end ? resume : chunk.end;
+            parse_chunk(chunk, end);
+        }
+        if (chunk.parsed_end > resume)
+            resume = chunk.parsed_end;
+
+        remap.resize(chunk.origins.origin_names.size());
+        for (size_t o = 0; o < remap.size(); ++o)
+        {
+            const std::string& name = chunk.origins.origin_names[o];
+            remap[o] = log_store_intern_origin(logs, name.data(), name.length());
+        }
+
+        // Unescape in place, the mapping is copy-on-write. Only done here because a
+        // speculative chunk may have misread quoting that the merge corrected.
+        for (size_t e = 0; e < chunk.escaped_rows.size(); ++e)
+        {
+            u32 r = chunk.escaped_rows[e];
+            char* content = file->data + (chunk.contents[r] - file->data);
+            chunk.content_lengths[r] = csv_unescape(content, content, chunk.content_lengths[r]);
+        }
+
+        for (size_t r = 0; r < chunk.timestamps.size(); ++r)
+        {
+            log_store_append_external(logs, source,
+                chunk.timestamps[r], (log_severity_e)chunk.severities[r],
+                remap[chunk.origin_ids[r]],
+                chunk.contents[r], chunk.content_lengths[r]);
+        }
+
+        // Release the columns early, large files produce large temporaries
+        std::vector<u64>().swap(chunk.timestamps);
+        std::vector<const char*>().swap(chunk.contents);
+        std::vector<u32>().swap(chunk.content_lengths);
+    }
+
+    return true;
+}
+//********************************************************************************************
+static bool has_extension(const char* filename, const char* extension)
+{
+    const char* ext = strrchr(filename, '.');
+    if (!ext || strlen(ext) != strlen(extension))
+        return false;
+    for (; *ext; ++ext, ++extension)
+    {
+        char c = *ext;
+        if (c >= 'A' && c <= 'Z')
+            c += 'a' - 'A';
+        if (c != *extension)
+            return false;
+    }
+    return true;
+}
+//********************************************************************************************
+bool save_logs_to_file(const char* filename, const log_snapshot_t& snapshot, log_progress_t* progress)
+{
+    if (has_extension(filename, ".bspy"))
+        return save_logs_to_bspy(filename, snapshot, progress);
+    if (has_extension(filename, ".jsonl"))
+        return save_logs_to_jsonl(filename, snapshot, progress);
+    return save_logs_to_csv(filename, snapshot, progress);
+}
+//********************************************************************************************
+bool load_logs_from_file(const char* filename, log_store_t& logs)
+{
+    if (has_extension(filename, ".bspy"))
+        return load_logs_from_bspy(filename, logs);
+    return load_logs_from_csv(filename, logs);
+}
+//********************************************************************************************
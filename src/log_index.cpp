@@ -0,0 +1,213 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#include <algorithm>
+#include <string.h>
+// INTERNAL INCLUDES
+#include "fuzzy_match.h"
+#include "log_index.h"
+#include "text_scan.h"
+#include "thread_pool.h"
+
+//********************************************************************************************
+static u32 trigram_hash(u32 trigram)
+{
+    return (trigram * 2654435761u) >> (32 - LOG_INDEX_HASH_BITS);
+}
+//********************************************************************************************
+static void build_keys(const log_segment_t& segment, const char* text, std::vector<u32>& keys)
+{
+    // Trigrams already seen in the current group, cleared through the touched list
+    std::vector<u64> seen((size_t)1 << (LOG_INDEX_HASH_BITS - 6));
+    std::vector<u32> touched;
+
+    for (u32 group_begin = 0; group_begin < segment.count; group_begin += LOG_INDEX_GROUP_ROWS)
+    {
+        u32 group_end = group_begin + LOG_INDEX_GROUP_ROWS;
+        if (group_end > segment.count)
+            group_end = segment.count;
+
+        for (u32 i = group_begin; i < group_end; ++i)
+        {
+            const u8* content = (const u8*)text + segment.content_offsets[i];
+            const u32 length = segment.content_lengths[i];
+            if (length < 3)
+                continue;
+
+            u32 trigram = (u32)(u8)scan_fold(content[0]) << 8 | (u32)(u8)scan_fold(content[1]) << 16;
+            for (u32 c = 2; c < length; ++c)
+            {
+                trigram = (trigram >> 8) | ((u32)(u8)scan_fold(content[c]) << 16);
+                u32 hash = trigram_hash(trigram);
+                u64 bit = (u64)1 << (hash & 63);
+                if (!(seen[hash >> 6] & bit))
+                {
+                    seen[hash >> 6] |= bit;
+                    touched.push_back(hash);
+                }
+            }
+        }
+
+        const u32 group = group_begin / LOG_INDEX_GROUP_ROWS;
+        for (size_t t = 0; t < touched.size(); ++t)
+        {
+            keys.push_back(touched[t] << LOG_INDEX_GROUP_BITS | group);
+            seen[touched[t] >> 6] = 0;
+        }
+        touched.clear();
+    }
+
+    std::sort(keys.begin(), keys.end());
+    keys.shrink_to_fit();
+}
+//********************************************************************************************
+static void index_segment(std::shared_ptr<log_index_job_t> job)
+{
+    std::vector<char> scratch;
+    const char* text = log_segment_read_text(*job->segment, scratch);
+    build_keys(*job->segment, text, job->keys);
+    job->done.store(true, std::memory_order_release);
+}
+//********************************************************************************************
+u32 log_index_update(log_store_t& store)
+{
+    // Install finished indexes, the job releases the segment afterwards. A segment a
+    // snapshot still reads must not change, those are installed on a later frame.
+    u32 installed_count = 0;
+    for (size_t j = 0; j < store.index_jobs.size();)
+    {
+        log_index_job_t& job = *store.index_jobs[j];
+        bool installed = job.done.load(std::memory_order_acquire);
+        for (size_t s = 0; s < store.segments.size() && installed; ++s)
+        {
+            if (store.segments[s] != job.segment)
+                continue;
+
+            // The store and the job hold one reference each
+            if (store.segments[s].use_count() > 2)
+            {
+                installed = false;
+                break;
+            }
+            store.segments[s]->trigram_keys.swap(job.keys);
+            store.segments[s]->indexed = true;
+            break;
+        }
+
+        if (installed)
+        {
+            store.index_jobs.erase(store.index_jobs.begin() + j);
+            installed_count++;
+        }
+        else
+        {
+            ++j;
+        }
+    }
+
+    // Index every segment that no longer receives entries
+    thread_pool_t& pool = thread_pool_shared();
+    const size_t max_jobs = pool.workers.size();
+    for (size_t s = 0; s + 1 < store.segments.size() && store.index_jobs.size() < max_jobs; ++s)
+    {
+        const std::shared_ptr<log_segment_t>& segment = store.segments[s];
+        if (segment->indexed)
+            continue;
+
+        bool pending = false;
+        for (size_t j = 0; j < store.index_jobs.size() && !pending; ++j)
+            pending = store.index_jobs[j]->segment == segment;
+        if (pending)
+            continue;
+
+        std::shared_ptr<log_index_job_t> job = std::make_shared<log_index_job_t>();
+        job->segment = segment;
+        job->done.store(false, std::memory_order_relaxed);
+        store.index_jobs.push_back(job);
+        thread_pool_submit(pool, [job]() { index_segment(job); });
+    }
+    return installed_count;
+}
+//********************************************************************************************
+bool log_index_candidates(const log_segment_t& segment, const char* token, size_t length, log_group_set_t& groups)
+{
+    if (!segment.indexed || length < 3)
+        return false;
+
+    memset(groups.bits, 0xFF, sizeof(groups.bits));
+
+    // Intersect the postings of every trigram of the token
+    const std::vector<u32>& keys = segment.trigram_keys;
+    u32 trigram = (u32)(u8)scan_fold(token[0]) << 8 | (u32)(u8)scan_fold(token[1]) << 16;
+    for (size_t c = 2; c < length; ++c)
+    {
+        trigram = (trigram >> 8) | ((u32)(u8)scan_fold(token[c]) << 16);
+        const u32 first = trigram_hash(trigram) << LOG_INDEX_GROUP_BITS;
+        const u32 last = first | (LOG_INDEX_GROUPS - 1);
+
+        log_group_set_t postings;
+        memset(postings.bits, 0, sizeof(postings.bits));
+        for (std::vector<u32>::const_iterator key = std::lower_bound(keys.begin(), keys.end(), first);
+            key != keys.end() && *key <= last; ++key)
+        {
+            u32 group = *key & (LOG_INDEX_GROUPS - 1);
+            postings.bits[group >> 6] |= (u64)1 << (group & 63);
+        }
+
+        u64 any = 0;
+        for (u32 w = 0; w < LOG_INDEX_GROUP_WORDS; ++w)
+        {
+            groups.bits[w] &= postings.bits[w];
+            any |= groups.bits[w];
+        }
+        if (!any)
+            break;
+    }
+    return true;
+}
+//********************************************************************************************
+bool log_index_fuzzy_candidates(
+    const log_segment_t& segment,
+    const char* token,
+    size_t length,
+    u32 max_edits,
+    log_group_set_t& groups)
+{
+    // Split into max_edits + 1 pieces, a match with max_edits edits leaves one intact
+    if (length > FUZZY_MAX_LENGTH)
+        length = FUZZY_MAX_LENGTH;
+    const size_t piece = length / (max_edits + 1);
+    if (piece < 3)
+        return false;
+
+    memset(groups.bits, 0, sizeof(groups.bits));
+    for (u32 p = 0; p <= max_edits; ++p)
+    {
+        log_group_set_t piece_groups;
+        if (!log_index_candidates(segment, token + p * piece, piece, piece_groups))
+            return false;
+        for (u32 w = 0; w < LOG_INDEX_GROUP_WORDS; ++w)
+            groups.bits[w] |= piece_groups.bits[w];
+    }
+    return true;
+}
+//********************************************************************************************
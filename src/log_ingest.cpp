@@ -0,0 +1,264 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#include <chrono>
+#include <string.h>
+// INTERNAL INCLUDES
+#include "log_ingest.h"
+#include "log_parser.h"
+
+#define QUEUE_MASK ((u64)LOG_INGEST_QUEUE_SIZE - 1)
+#define RECORD_HEADER_SIZE 8
+
+//********************************************************************************************
+typedef struct record_header_t
+{
+    u32 length;
+    u32 kind;
+} record_header_t;
+//********************************************************************************************
+static size_t record_size(size_t length)
+{
+    // Records are kept 8 byte aligned so a header never straddles the end of the queue
+    return (RECORD_HEADER_SIZE + length + 7) & ~(size_t)7;
+}
+//********************************************************************************************
+static void wake_parser(log_ingest_t& ingest)
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (ingest.parser_waiting.load())
+    {
+        std::lock_guard<std::mutex> lock(ingest.wake_mutex);
+        ingest.wake.notify_one();
+    }
+}
+//********************************************************************************************
+static void wait_for_space(log_ingest_t& ingest, u64 head, size_t needed)
+{
+    // The parser is behind, hold the sender back rather than dropping messages
+    while (LOG_INGEST_QUEUE_SIZE - (head - ingest.tail.load(std::memory_order_acquire)) < needed)
+    {
+        wake_parser(ingest);
+        std::this_thread::yield();
+    }
+}
+//********************************************************************************************
+bool log_ingest_push(log_ingest_t& ingest, log_ingest_kind_e kind, const void* data, size_t length)
+{
+    if (!data || length == 0)
+        return false;
+
+    const size_t needed = record_size(length);
+    if (needed > LOG_INGEST_QUEUE_SIZE / 2)
+    {
+        ingest.rejected++;
+        return false;
+    }
+
+    char* queue = ingest.queue.get();
+    u64 head = ingest.head.load(std::memory_order_relaxed);
+    size_t pos = (size_t)(head & QUEUE_MASK);
+    size_t contiguous = LOG_INGEST_QUEUE_SIZE - pos;
+
+    if (contiguous < needed)
+    {
+        // Pad to the end of the queue and continue at the start
+        wait_for_space(ingest, head, contiguous);
+        record_header_t* header = (record_header_t*)(queue + pos);
+        header->length = (u32)(contiguous - RECORD_HEADER_SIZE);
+        header->kind = LOG_INGEST_WRAP;
+        head += contiguous;
+        pos = 0;
+    }
+
+    wait_for_space(ingest, head, needed);
+    record_header_t* header = (record_header_t*)(queue + pos);
+    header->length = (u32)length;
+    header->kind = kind;
+    memcpy(queue + pos + RECORD_HEADER_SIZE, data, length);
+    ingest.head.store(head + needed, std::memory_order_release);
+
+    wake_parser(ingest);
+    return true;
+}
+//********************************************************************************************
+log_batch_t* log_ingest_acquire_batch(log_ingest_t& ingest)
+{
+    log_batch_t* batch = NULL;
+    {
+        std::lock_guard<std::mutex> lock(ingest.batch_mutex);
+        if (!ingest.spare.empty())
+        {
+            batch = ingest.spare.back();
+            ingest.spare.pop_back();
+        }
+    }
+
+    if (!batch)
+        batch = new log_batch_t();
+
+    log_batch_clear(*batch);
+    return batch;
+}
+//********************************************************************************************
+void log_ingest_publish(log_ingest_t& ingest, log_batch_t* batch)
+{
+    bool first;
+    {
+        std::lock_guard<std::mutex> lock(ingest.batch_mutex);
+        first = ingest.ready.empty();
+        ingest.ready.push_back(batch);
+    }
+
+    // The UI takes every ready batch at once, so only the first one has to wake it
+    if (first && ingest.notify)
+        ingest.notify(ingest.notify_user);
+}
+//********************************************************************************************
+void log_ingest_parse(log_batch_t& batch, u32 kind, const char* data, size_t length)
+{
+    if (kind == LOG_INGEST_RECORD)
+    {
+        log_record_t record;
+        if (log_parse_record(data, length, record))
+        {
+            log_batch_add_record(batch, record);
+        }
+    }
+    else if (kind == LOG_INGEST_LINES)
+    {
+        log_parse_lines(data, length, batch);
+    }
+}
+//********************************************************************************************
+static void parser_main(log_ingest_t* ingest)
+{
+    const char* queue = ingest->queue.get();
+    log_batch_t* batch = NULL;
+
+    while (true)
+    {
+        u64 tail = ingest->tail.load(std::memory_order_relaxed);
+        u64 head = ingest->head.load(std::memory_order_acquire);
+
+        if (tail == head)
+        {
+            // Queue drained, hand what we have to the UI
+            if (batch)
+            {
+                log_ingest_publish(*ingest, batch);
+                batch = NULL;
+            }
+
+            if (!ingest->running.load())
+                break;
+
+            std::unique_lock<std::mutex> lock(ingest->wake_mutex);
+            ingest->parser_waiting.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (ingest->head.load() == tail && ingest->running.load())
+                ingest->wake.wait_for(lock, std::chrono::milliseconds(10));
+            ingest->parser_waiting.store(false);
+            continue;
+        }
+
+        while (tail != head)
+        {
+            const char* record = queue + (tail & QUEUE_MASK);
+            const record_header_t* header = (const record_header_t*)record;
+
+            if (header->kind != LOG_INGEST_WRAP)
+            {
+                if (!batch)
+                    batch = log_ingest_acquire_batch(*ingest);
+                log_ingest_parse(*batch, header->kind, record + RECORD_HEADER_SIZE, header->length);
+            }
+
+            tail += record_size(header->length);
+            ingest->tail.store(tail, std::memory_order_release);
+
+            if (batch && batch->count >= LOG_INGEST_BATCH_ENTRIES)
+            {
+                log_ingest_publish(*ingest, batch);
+                batch = NULL;
+            }
+        }
+    }
+}
+//********************************************************************************************
+void log_ingest_start(log_ingest_t& ingest)
+{
+    ingest.queue.reset(new char[LOG_INGEST_QUEUE_SIZE]);
+    ingest.head.store(0);
+    ingest.tail.store(0);
+    ingest.rejected.store(0);
+    ingest.parser_waiting.store(false);
+    ingest.running.store(true);
+    ingest.parser = std::thread(parser_main, &ingest);
+}
+//********************************************************************************************
+void log_ingest_stop(log_ingest_t& ingest)
+{
+    if (!ingest.parser.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(ingest.wake_mutex);
+        ingest.running.store(false);
+        ingest.wake.notify_one();
+    }
+    ingest.parser.join();
+
+    std::lock_guard<std::mutex> lock(ingest.batch_mutex);
+    for (size_t i = 0; i < ingest.ready.size(); ++i)
+        delete ingest.ready[i];
+    for (size_t i = 0; i < ingest.spare.size(); ++i)
+        delete ingest.spare[i];
+    ingest.ready.clear();
+    ingest.spare.clear();
+}
+//********************************************************************************************
+u64 log_ingest_drain(log_ingest_t& ingest, log_store_t& store)
+{
+    std::vector<log_batch_t*>& taken = ingest.taken;
+    {
+        std::lock_guard<std::mutex> lock(ingest.batch_mutex);
+        taken.swap(ingest.ready);
+    }
+
+    // Append outside the lock so the parser keeps going
+    u64 appended = 0;
+    for (size_t i = 0; i < taken.size(); ++i)
+    {
+        log_store_append_batch(store, *taken[i]);
+        appended += taken[i]->count;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(ingest.batch_mutex);
+        ingest.spare.insert(ingest.spare.end(), taken.begin(), taken.end());
+    }
+    taken.clear();
+
+    return appended;
+}
+//********************************************************************************************
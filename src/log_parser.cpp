@@ -0,0 +1,282 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#include <string.h>
+// INTERNAL INCLUDES
+#include "csv_codec.h"
+#include "log_parser.h"
+#include "text_scan.h"
+
+#define SEVERITY_KEY(a, b, c, d) ((u32)(a) | ((u32)(b) << 8) | ((u32)(c) << 16) | ((u32)(d) << 24))
+
+//********************************************************************************************
+static bool find_severity(const char* str, size_t length, log_severity_e& severity)
+{
+    if (length != 4)
+        return false;
+
+    // Fold to upper case and compare all four characters at once
+    u32 key = 0;
+    for (u32 i = 0; i < 4; ++i)
+    {
+        u8 c = (u8)str[i];
+        if (c >= 'a' && c <= 'z')
+            c -= 'a' - 'A';
+        key |= (u32)c << (i * 8);
+    }
+
+    switch (key)
+    {
+    case SEVERITY_KEY('I', 'N', 'F', 'O'): severity = INFO; return true;
+    case SEVERITY_KEY('W', 'A', 'R', 'N'): severity = WARN; return true;
+    case SEVERITY_KEY('F', 'A', 'I', 'L'): severity = FAIL; return true;
+    case SEVERITY_KEY('S', 'U', 'C', 'C'): severity = SUCC; return true;
+    case SEVERITY_KEY('C', 'R', 'I', 'T'): severity = CRIT; return true;
+    case SEVERITY_KEY('D', 'B', 'U', 'G'): severity = DBUG; return true;
+    case SEVERITY_KEY('T', 'R', 'C', 'E'): severity = TRCE; return true;
+    default: return false;
+    }
+}
+//********************************************************************************************
+log_severity_e log_parse_severity(const char* str, size_t length)
+{
+    log_severity_e severity;
+    if (!find_severity(str, length, severity))
+        return INFO; // default
+    return severity;
+}
+//********************************************************************************************
+bool log_looks_like_record(const char* p, const char* end)
+{
+    // Timestamp, either digits or "seconds.fraction"
+    const char* digits = p;
+    while (p < end && *p >= '0' && *p <= '9')
+        p++;
+    if (p > digits && p < end && *p == '.')
+    {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9')
+            p++;
+    }
+    if (p == digits || p >= end || *p != ',')
+        return false;
+
+    // Followed by a known severity
+    p++;
+    log_severity_e severity;
+    return end - p > 4 && p[4] == ',' && find_severity(p, 4, severity);
+}
+//********************************************************************************************
+u64 log_parse_timestamp(const char* str, size_t length)
+{
+    u64 value = 0;
+    size_t i = 0;
+    for (; i < length; ++i)
+    {
+        u32 digit = (u8)str[i] - '0';
+        if (digit > 9)
+            break;
+        value = value * 10 + digit;
+    }
+
+    // "seconds.fraction", digits past nanoseconds are dropped
+    if (i < length && str[i] == '.')
+    {
+        u64 fraction = 0;
+        u64 scale = LOG_NS_PER_SECOND;
+        for (++i; i < length && scale > 1; ++i)
+        {
+            u32 digit = (u8)str[i] - '0';
+            if (digit > 9)
+                break;
+            scale /= 10;
+            fraction += digit * scale;
+        }
+        return value * LOG_NS_PER_SECOND + fraction;
+    }
+
+    // Plain integers are taken by magnitude, any current date in seconds stays below 1e11
+    // and the same date in milliseconds, microseconds or nanoseconds above it
+    if (value < 100000000000ull)
+        return value * LOG_NS_PER_SECOND;
+    if (value < 100000000000000ull)
+        return value * 1000000;
+    if (value < 100000000000000000ull)
+        return value * 1000;
+    return value;
+}
+//********************************************************************************************
+// Finds the quote closing a quoted field body starting at p. The closing quote must be
+// followed by terminator, or by the line end when terminator is '\n'. Doubled quotes are
+// escapes. Returns NULL if the field never closes or holds a quote that is neither, so an
+// unterminated field stops at the next quoted field instead of swallowing the records up
+// to it; the caller then reads it unquoted.
+static const char* find_closing_quote(const char* p, const char* end, char terminator, bool& escaped)
+{
+    escaped = false;
+    while (p < end)
+    {
+        p = scan_find(p, end, '"');
+        if (p == end)
+            break;
+        const char* after = p + 1;
+        if (after < end && *after == '"')
+        {
+            escaped = true;
+            p += 2;
+            continue;
+        }
+        if (terminator == '\n' && after < end && *after == '\r')
+            after++;
+        if (after < end ? *after == terminator : terminator == '\n')
+            return p;
+        break;
+    }
+    return NULL;
+}
+//********************************************************************************************
+const char* log_parse_line(const char* data, const char* end, log_record_t& record, bool& valid)
+{
+    valid = false;
+    record.origin_escaped = false;
+    record.content_escaped = false;
+
+    // Timestamp, severity and origin
+    const char* field_begin[3];
+    const char* field_end[3];
+    const char* p = data;
+    for (u32 i = 0; i < 3; ++i)
+    {
+        if (i == 2 && p < end && *p == '"')
+        {
+            // Quoted origin, may contain commas and line breaks
+            const char* quote = find_closing_quote(p + 1, end, ',', record.origin_escaped);
+            if (quote)
+            {
+                field_begin[i] = p + 1;
+                field_end[i] = quote;
+                p = quote + 2;
+                continue;
+            }
+            record.origin_escaped = false;
+        }
+
+        const char* field = scan_find_either(p, end, ',', '\n');
+        if (field == end || *field != ',')
+        {
+            // Malformed line, skip it
+            const char* newline = scan_find(field, end, '\n');
+            return newline < end ? newline + 1 : end;
+        }
+        field_begin[i] = p;
+        field_end[i] = field;
+        p = field + 1;
+    }
+
+    record.timestamp = log_parse_timestamp(field_begin[0], field_end[0] - field_begin[0]);
+    record.severity = log_parse_severity(field_begin[1], field_end[1] - field_begin[1]);
+    record.origin = field_begin[2];
+    record.origin_length = (u32)(field_end[2] - field_begin[2]);
+
+    // Content runs until the end of the line and may contain commas. Quoted content
+    // may also span lines.
+    const char* content_end = NULL;
+    const char* next;
+    if (p < end && *p == '"')
+    {
+        content_end = find_closing_quote(p + 1, end, '\n', record.content_escaped);
+        if (content_end)
+        {
+            p++;
+            next = scan_find(content_end, end, '\n');
+            next = next < end ? next + 1 : end;
+        }
+    }
+    if (!content_end)
+    {
+        // Unquoted, or a quote that never closes which is taken as plain text
+        record.content_escaped = false;
+        content_end = scan_find(p, end, '\n');
+        next = content_end < end ? content_end + 1 : end;
+        if (content_end > p && content_end[-1] == '\r')
+            content_end--;
+    }
+
+    record.content = p;
+    record.content_length = (u32)(content_end - p);
+    valid = true;
+    return next;
+}
+//********************************************************************************************
+bool log_parse_record(const char* data, size_t length, log_record_t& record)
+{
+    // Senders usually include the terminating zero
+    const char* terminator = (const char*)memchr(data, '\0', length);
+    const char* end = terminator ? terminator : data + length;
+
+    bool valid;
+    log_parse_line(data, end, record, valid);
+    return valid;
+}
+//********************************************************************************************
+u32 log_parse_lines(const char* data, size_t length, log_batch_t& batch)
+{
+    const char* terminator = (const char*)memchr(data, '\0', length);
+    const char* end = terminator ? terminator : data + length;
+
+    u32 parsed = 0;
+    const char* p = data;
+    while (p < end)
+    {
+        log_record_t record;
+        bool valid;
+        p = log_parse_line(p, end, record, valid);
+        if (valid)
+        {
+            log_batch_add_record(batch, record);
+            parsed++;
+        }
+    }
+    return parsed;
+}
+//********************************************************************************************
+void log_batch_add_record(log_batch_t& batch, const log_record_t& record)
+{
+    log_batch_add(batch, record.timestamp, record.severity,
+        record.origin, record.origin_length,
+        record.content, record.content_length);
+    if (!record.origin_escaped && !record.content_escaped)
+        return;
+
+    // Collapse doubled quotes in the copies, content moves down behind the shorter origin
+    u32 i = batch.count - 1;
+    char* text = batch.text.data();
+    u32 origin = batch.origin_offsets[i];
+    u32 origin_length = csv_unescape(text + origin, text + origin, batch.origin_lengths[i]);
+    u32 content = origin + origin_length;
+    u32 content_length = csv_unescape(text + content, text + batch.content_offsets[i], batch.content_lengths[i]);
+    batch.origin_lengths[i] = origin_length;
+    batch.content_offsets[i] = content;
+    batch.content_lengths[i] = content_length;
+    batch.text.resize(content + content_length);
+}
+//********************************************************************************************
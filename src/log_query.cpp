@@ -0,0 +1,793 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#include <algorithm>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+// INTERNAL INCLUDES
+#include "log_query.h"
+#include "fuzzy_match.h"
+#include "log_index.h"
+#include "log_parser.h"
+#include "text_scan.h"
+
+#define QUERY_NO_NODE 0xFFFFFFFFu
+
+//********************************************************************************************
+typedef enum query_token_e
+{
+    TOKEN_END,
+    TOKEN_LPAREN,
+    TOKEN_RPAREN,
+    TOKEN_AND,
+    TOKEN_OR,
+    TOKEN_NOT,
+    TOKEN_TERM
+} query_token_e;
+//********************************************************************************************
+typedef struct query_parser_t
+{
+    const char* p;
+    log_query_t* query;
+    query_token_e token;
+    u32 term;           // node of the current TOKEN_TERM
+    bool syntax;        // anything beyond plain words was seen
+    bool failed;
+} query_parser_t;
+//********************************************************************************************
+// Order of the severities from least to most severe, indexed by log_severity_e
+static const u8 severity_rank[7] = { 2, 4, 5, 3, 6, 1, 0 };
+
+//********************************************************************************************
+static void fail(query_parser_t& parser, const std::string& message)
+{
+    if (!parser.failed)
+    {
+        parser.failed = true;
+        parser.query->error = message;
+    }
+}
+//********************************************************************************************
+static u32 add_node(log_query_t& query, log_query_op_e op)
+{
+    query.nodes.emplace_back();
+    query.nodes.back().op = op;
+    return (u32)query.nodes.size() - 1;
+}
+//********************************************************************************************
+static bool starts_with(const std::string& text, const char* prefix)
+{
+    return text.compare(0, strlen(prefix), prefix) == 0;
+}
+//********************************************************************************************
+// Reads a quoted string starting at its opening quote, \" and \\ are unescaped
+static bool read_quoted(const char*& p, std::string& out)
+{
+    ++p;
+    while (*p && *p != '"')
+    {
+        if (*p == '\\' && (p[1] == '"' || p[1] == '\\'))
+            ++p;
+        out += *p++;
+    }
+    if (*p != '"')
+        return false;
+    ++p;
+    return true;
+}
+//********************************************************************************************
+static bool parse_severity(query_parser_t& parser, const std::string& word, u8& severities)
+{
+    // sev>=WARN, sev<=INFO, sev>FAIL, sev<WARN, sev=CRIT or sev:CRIT
+    size_t pos = 3;
+    i32 compare = 0;    // -1 below, 0 equal, 1 above
+    bool inclusive = true;
+    if (word[pos] == '>' || word[pos] == '<')
+    {
+        compare = word[pos] == '>' ? 1 : -1;
+        ++pos;
+        inclusive = word[pos] == '=';
+        if (inclusive)
+            ++pos;
+    }
+    else
+    {
+        ++pos;
+    }
+
+    const std::string name = word.substr(pos);
+    i32 level = -1;
+    for (u32 s = 0; s <= TRCE; ++s)
+    {
+        const char* severity_str = severity_to_string((log_severity_e)s);
+        if (name.length() == strlen(severity_str) &&
+            std::equal(name.begin(), name.end(), severity_str,
+                [](char a, char b) { return toupper((u8)a) == b; }))
+        {
+            level = (i32)s;
+        }
+    }
+    if (level < 0)
+    {
+        fail(parser, "Unknown severity '" + name + "'");
+        return false;
+    }
+
+    severities = 0;
+    for (u32 s = 0; s <= TRCE; ++s)
+    {
+        const i32 delta = (i32)severity_rank[s] - (i32)severity_rank[level];
+        const bool match = (delta == 0 && inclusive) || (compare > 0 && delta > 0) || (compare < 0 && delta < 0);
+        if (match)
+            severities |= (u8)(1 << s);
+    }
+    return true;
+}
+//********************************************************************************************
+static bool parse_bound(query_parser_t& parser, const std::string& text, u64& timestamp)
+{
+    // Same forms as the timestamp field of a record
+    const size_t digits = strspn(text.c_str(), "0123456789.");
+    if (digits != text.length() || std::count(text.begin(), text.end(), '.') > 1 || text[0] == '.')
+    {
+        fail(parser, "Invalid timestamp '" + text + "'");
+        return false;
+    }
+    timestamp = log_parse_timestamp(text.data(), text.length());
+    return true;
+}
+//********************************************************************************************
+static bool parse_time(query_parser_t& parser, const std::string& word, u64& time_min, u64& time_max)
+{
+    // ts:[a,b] with either bound optional
+    const size_t comma = word.find(',');
+    if (word.back() != ']' || comma == std::string::npos)
+    {
+        fail(parser, "Expected ts:[from,to]");
+        return false;
+    }
+
+    const std::string from = word.substr(4, comma - 4);
+    const std::string to = word.substr(comma + 1, word.length() - comma - 2);
+    if (!from.empty() && !parse_bound(parser, from, time_min))
+        return false;
+    if (!to.empty() && !parse_bound(parser, to, time_max))
+        return false;
+
+    // An upper bound in whole seconds covers the rest of that second
+    if (!to.empty() && to.find('.') == std::string::npos && strtoull(to.c_str(), NULL, 10) < 100000000000ull)
+        time_max += LOG_NS_PER_SECOND - 1;
+    return true;
+}
+//********************************************************************************************
+static void next_token(query_parser_t& parser)
+{
+    log_query_t& query = *parser.query;
+    const char*& p = parser.p;
+    while (*p == ' ' || *p == '\t')
+        ++p;
+
+    if (!*p)
+    {
+        parser.token = TOKEN_END;
+        return;
+    }
+    if (*p == '(' || *p == ')')
+    {
+        parser.token = *p++ == '(' ? TOKEN_LPAREN : TOKEN_RPAREN;
+        parser.syntax = true;
+        return;
+    }
+    if (*p == ',')
+    {
+        ++p;
+        parser.token = TOKEN_OR;
+        return;
+    }
+    if (*p == '!' && p[1] && p[1] != ' ' && p[1] != ',')
+    {
+        ++p;
+        parser.token = TOKEN_NOT;
+        return;
+    }
+
+    parser.token = TOKEN_TERM;
+    if (*p == '"')
+    {
+        parser.term = add_node(query, QUERY_TEXT);
+        if (!read_quoted(p, query.nodes[parser.term].text))
+            fail(parser, "Missing closing quote");
+        parser.syntax = true;
+        return;
+    }
+
+    if (*p == '/')
+    {
+        // A regex ends at a '/' followed by a separator, so paths stay plain words
+        const char* end = p + 1;
+        while (*end && !(*end == '/' && (!end[1] || strchr(" \t,)", end[1]))))
+            end += (*end == '\\' && end[1]) ? 2 : 1;
+
+        if (*end == '/' && end > p + 1)
+        {
+            std::string pattern;
+            for (const char* c = p + 1; c < end; ++c)
+            {
+                if (*c == '\\' && c + 1 < end && c[1] == '/')
+                    ++c;
+                pattern += *c;
+            }
+            p = end + 1;
+            parser.syntax = true;
+            parser.term = add_node(query, QUERY_REGEX);
+            try
+            {
+                std::regex::flag_type flags = std::regex::ECMAScript | std::regex::optimize;
+                if (query.ignore_case)
+                    flags |= std::regex::icase;
+                query.nodes[parser.term].regex = std::make_shared<std::regex>(pattern, flags);
+            }
+            catch (const std::regex_error& e)
+            {
+                fail(parser, std::string("Invalid regex: ") + e.what());
+            }
+            return;
+        }
+    }
+
+    // Plain word, quoted parts included so origin:"a b" stays one word and the
+    // comma of a ts:[a,b] range does not end it
+    std::string word;
+    bool range = false;
+    while (*p && (range || !strchr(" \t(),", *p)))
+    {
+        if (*p == '[' || *p == ']')
+            range = *p == '[';
+        if (*p == '"')
+        {
+            if (!read_quoted(p, word))
+                fail(parser, "Missing closing quote");
+            continue;
+        }
+        word += *p++;
+    }
+
+    if (word == "AND" || word == "&&" || word == "OR" || word == "||" || word == "NOT")
+    {
+        parser.token = word[0] == 'A' || word[0] == '&' ? TOKEN_AND : word[0] == 'N' ? TOKEN_NOT : TOKEN_OR;
+        parser.syntax = true;
+    }
+    else if (starts_with(word, "origin:"))
+    {
+        parser.term = add_node(query, QUERY_ORIGIN);
+        query.nodes[parser.term].text = word.substr(7);
+        parser.syntax = true;
+    }
+    else if (starts_with(word, "sev") && word.length() > 3 && strchr("<>=:", word[3]))
+    {
+        parser.term = add_node(query, QUERY_SEVERITY);
+        parse_severity(parser, word, query.nodes[parser.term].severities);
+        parser.syntax = true;
+    }
+    else if (starts_with(word, "ts:["))
+    {
+        parser.term = add_node(query, QUERY_TIME);
+        log_query_node_t& node = query.nodes[parser.term];
+        parse_time(parser, word, node.time_min, node.time_max);
+        parser.syntax = true;
+    }
+    else
+    {
+        parser.term = add_node(query, QUERY_TEXT);
+        query.nodes[parser.term].text = word;
+    }
+}
+//********************************************************************************************
+static u32 parse_or(query_parser_t& parser);
+//********************************************************************************************
+static u32 parse_primary(query_parser_t& parser)
+{
+    if (parser.token == TOKEN_LPAREN)
+    {
+        next_token(parser);
+        u32 node = parse_or(parser);
+        if (parser.token != TOKEN_RPAREN)
+            fail(parser, "Missing )");
+        next_token(parser);
+        return node;
+    }
+    if (parser.token == TOKEN_TERM)
+    {
+        u32 node = parser.term;
+        next_token(parser);
+        return node;
+    }
+
+    fail(parser, "Expected a term");
+    return QUERY_NO_NODE;
+}
+//********************************************************************************************
+static u32 parse_not(query_parser_t& parser)
+{
+    if (parser.token != TOKEN_NOT)
+        return parse_primary(parser);
+
+    next_token(parser);
+    u32 child = parse_not(parser);
+    u32 node = add_node(*parser.query, QUERY_NOT);
+    parser.query->nodes[node].children.push_back(child);
+    return node;
+}
+//********************************************************************************************
+static u32 parse_and(query_parser_t& parser)
+{
+    std::vector<u32> children;
+    children.push_back(parse_not(parser));
+
+    // Terms next to each other are joined by AND as well
+    while (!parser.failed)
+    {
+        if (parser.token == TOKEN_AND)
+            next_token(parser);
+        else if (parser.token != TOKEN_TERM && parser.token != TOKEN_NOT && parser.token != TOKEN_LPAREN)
+            break;
+        children.push_back(parse_not(parser));
+    }
+
+    if (children.size() == 1)
+        return children[0];
+    u32 node = add_node(*parser.query, QUERY_AND);
+    parser.query->nodes[node].children.swap(children);
+    return node;
+}
+//********************************************************************************************
+static u32 parse_or(query_parser_t& parser)
+{
+    std::vector<u32> children;
+    children.push_back(parse_and(parser));
+
+    while (!parser.failed && parser.token == TOKEN_OR)
+    {
+        next_token(parser);
+        children.push_back(parse_and(parser));
+    }
+
+    if (children.size() == 1)
+        return children[0];
+    u32 node = add_node(*parser.query, QUERY_OR);
+    parser.query->nodes[node].children.swap(children);
+    return node;
+}
+//********************************************************************************************
+static bool mark_exact(log_query_t& query, u32 id)
+{
+    log_query_node_t& node = query.nodes[id];
+    switch (node.op)
+    {
+    case QUERY_TEXT:
+    case QUERY_REGEX:
+        node.exact = false;
+        break;
+    case QUERY_ORIGIN:
+    case QUERY_SEVERITY:
+    case QUERY_TIME:
+        node.exact = true;
+        break;
+    default:
+    {
+        bool exact = true;
+        for (size_t c = 0; c < node.children.size(); ++c)
+            exact &= mark_exact(query, node.children[c]);
+        query.nodes[id].exact = exact;
+        break;
+    }
+    }
+    return query.nodes[id].exact;
+}
+//********************************************************************************************
+bool log_query_compile(log_query_t& query, const char* text, bool ignore_case, u32 max_edits)
+{
+    query.nodes.clear();
+    query.error.clear();
+    query.active = false;
+    query.root = 0;
+    query.ignore_case = ignore_case;
+    query.max_edits = max_edits;
+
+    query_parser_t parser = {};
+    parser.p = text;
+    parser.query = &query;
+    next_token(parser);
+    if (parser.token == TOKEN_END)
+        return true;
+
+    u32 root = parse_or(parser);
+    if (parser.token != TOKEN_END)
+        fail(parser, "Unexpected )");
+
+    // Plain substrings keep their comma separated meaning
+    query.active = parser.syntax;
+    if (!query.active)
+    {
+        query.nodes.clear();
+        query.error.clear();
+        return true;
+    }
+    if (parser.failed)
+    {
+        // Text such as "render()" that only looks like a query stays a substring filter,
+        // the error just tells why it was not taken as a query
+        query.nodes.clear();
+        query.active = false;
+        return false;
+    }
+
+    query.root = root;
+    mark_exact(query, root);
+
+    // Content and origin terms are compared folded, fuzzy terms carry their Bitap masks
+    for (size_t n = 0; n < query.nodes.size(); ++n)
+    {
+        log_query_node_t& node = query.nodes[n];
+        if (node.op != QUERY_TEXT && node.op != QUERY_ORIGIN)
+            continue;
+
+        if (node.op == QUERY_TEXT && max_edits > 0)
+        {
+            std::shared_ptr<fuzzy_pattern_t> fuzzy = std::make_shared<fuzzy_pattern_t>();
+            fuzzy_pattern_init(*fuzzy, node.text.data(), node.text.length(), max_edits, ignore_case);
+            node.fuzzy = fuzzy;
+        }
+        if (ignore_case)
+        {
+            for (size_t c = 0; c < node.text.length(); ++c)
+                node.text[c] = scan_fold(node.text[c]);
+        }
+    }
+    return true;
+}
+//********************************************************************************************
+void log_query_update_origins(log_query_t& query, const std::vector<std::string>& origin_names)
+{
+    for (size_t n = 0; n < query.nodes.size(); ++n)
+    {
+        log_query_node_t& node = query.nodes[n];
+        if (node.op != QUERY_ORIGIN)
+            continue;
+
+        for (size_t i = node.origin_matches.size(); i < origin_names.size(); ++i)
+        {
+            const std::string& origin = origin_names[i];
+            const char* found = query.ignore_case ?
+                scan_find_text_folded(origin.data(), origin.length(), node.text.data(), node.text.length()) :
+                scan_find_text(origin.data(), origin.length(), node.text.data(), node.text.length());
+            node.origin_matches.push_back(found != NULL);
+        }
+    }
+}
+//********************************************************************************************
+typedef struct query_stats_t
+{
+    u64 total;
+    u64 severities[8];
+    std::vector<u64> origins;
+} query_stats_t;
+//********************************************************************************************
+static void estimate(log_query_t& query, u32 id, const query_stats_t& stats)
+{
+    log_query_node_t& node = query.nodes[id];
+    const float total = stats.total ? (float)stats.total : 1.0f;
+
+    switch (node.op)
+    {
+    case QUERY_TEXT:
+        node.cost = node.fuzzy ? 8.0f : 4.0f;
+        node.selectivity = std::min(0.5f, std::max(0.01f, (1.0f + query.max_edits) / (1.0f + node.text.length())));
+        break;
+    case QUERY_REGEX:
+        node.cost = 40.0f;
+        node.selectivity = 0.5f;
+        break;
+    case QUERY_ORIGIN:
+    {
+        u64 rows = 0;
+        for (size_t o = 0; o < stats.origins.size() && o < node.origin_matches.size(); ++o)
+            rows += node.origin_matches[o] ? stats.origins[o] : 0;
+        node.cost = 1.0f;
+        node.selectivity = rows / total;
+        break;
+    }
+    case QUERY_SEVERITY:
+    {
+        u64 rows = 0;
+        for (u32 s = 0; s < 8; ++s)
+            rows += ((node.severities >> s) & 1) ? stats.severities[s] : 0;
+        node.cost = 1.0f;
+        node.selectivity = rows / total;
+        break;
+    }
+    case QUERY_TIME:
+        node.cost = 1.0f;
+        node.selectivity = 0.5f;
+        break;
+    case QUERY_NOT:
+        estimate(query, node.children[0], stats);
+        query.nodes[id].cost = query.nodes[node.children[0]].cost;
+        query.nodes[id].selectivity = 1.0f - query.nodes[node.children[0]].selectivity;
+        break;
+    case QUERY_AND:
+    case QUERY_OR:
+    {
+        const bool is_and = node.op == QUERY_AND;
+        std::vector<u32> children = node.children;
+        for (size_t c = 0; c < children.size(); ++c)
+            estimate(query, children[c], stats);
+
+        // AND runs first what is cheap and likely to fail, OR what is cheap and likely
+        // to succeed, either decides the result early
+        const std::vector<log_query_node_t>& nodes = query.nodes;
+        std::stable_sort(children.begin(), children.end(), [&](u32 a, u32 b)
+        {
+            const float decide_a = is_and ? 1.0f - nodes[a].selectivity : nodes[a].selectivity;
+            const float decide_b = is_and ? 1.0f - nodes[b].selectivity : nodes[b].selectivity;
+            return nodes[a].cost / std::max(decide_a, 0.001f) < nodes[b].cost / std::max(decide_b, 0.001f);
+        });
+
+        float cost = 0.0f;
+        float reach = 1.0f;     // fraction of rows that get to the next operand
+        for (size_t c = 0; c < children.size(); ++c)
+        {
+            const log_query_node_t& child = nodes[children[c]];
+            cost += reach * child.cost;
+            reach *= is_and ? child.selectivity : 1.0f - child.selectivity;
+        }
+
+        log_query_node_t& planned = query.nodes[id];
+        planned.children.swap(children);
+        planned.cost = cost;
+        planned.selectivity = is_and ? reach : 1.0f - reach;
+        break;
+    }
+    }
+}
+//********************************************************************************************
+void log_query_plan(log_query_t& query, const log_store_t& store)
+{
+    if (query.nodes.empty())
+        return;
+
+    // Row counts per severity and origin straight from the segment bitmaps
+    query_stats_t stats = {};
+    stats.origins.resize(store.origin_names.size() + 1, 0);
+    for (size_t s = 0; s < store.segments.size(); ++s)
+    {
+        const log_segment_t& segment = *store.segments[s];
+        stats.total += segment.count;
+
+        const log_bitmap_set_t& severity_rows = segment.severity_rows;
+        for (size_t b = 0; b < severity_rows.values.size(); ++b)
+            stats.severities[severity_rows.values[b] & 7] += severity_rows.bitmaps[b].cardinality;
+
+        const log_bitmap_set_t& origin_rows = segment.origin_rows;
+        for (size_t b = 0; b < origin_rows.values.size(); ++b)
+        {
+            if (origin_rows.values[b] < stats.origins.size())
+                stats.origins[origin_rows.values[b]] += origin_rows.bitmaps[b].cardinality;
+        }
+    }
+
+    estimate(query, query.root, stats);
+}
+//********************************************************************************************
+static void fill_rows(u64* rows, u32 count)
+{
+    const u32 full_words = count / 64;
+    memset(rows, 0xFF, full_words * sizeof(u64));
+    memset(rows + full_words, 0, (LOG_BITMAP_WORDS - full_words) * sizeof(u64));
+    if (count & 63)
+        rows[full_words] = ((u64)1 << (count & 63)) - 1;
+}
+//********************************************************************************************
+static void node_rows(const log_query_t& query, u32 id, const log_segment_t& segment, u64* rows)
+{
+    // One word of the row mask covers exactly one index group
+    static_assert(LOG_INDEX_GROUP_ROWS == 64, "row mask words and index groups differ");
+
+    const log_query_node_t& node = query.nodes[id];
+    switch (node.op)
+    {
+    case QUERY_TEXT:
+    {
+        fill_rows(rows, segment.count);
+        log_group_set_t groups;
+        const bool indexed = node.fuzzy ?
+            log_index_fuzzy_candidates(segment, node.text.data(), node.text.length(), node.fuzzy->max_edits, groups) :
+            log_index_candidates(segment, node.text.data(), node.text.length(), groups);
+        if (indexed)
+        {
+            for (u32 w = 0; w < LOG_BITMAP_WORDS; ++w)
+                rows[w] &= log_group_test(groups, w) ? ~(u64)0 : 0;
+        }
+        break;
+    }
+    case QUERY_REGEX:
+        fill_rows(rows, segment.count);
+        break;
+    case QUERY_ORIGIN:
+    {
+        memset(rows, 0, LOG_BITMAP_WORDS * sizeof(u64));
+        const log_bitmap_set_t& origin_rows = segment.origin_rows;
+        for (size_t b = 0; b < origin_rows.values.size(); ++b)
+        {
+            const u16 origin = origin_rows.values[b];
+            if (origin < node.origin_matches.size() && node.origin_matches[origin])
+                log_bitmap_or(origin_rows.bitmaps[b], rows);
+        }
+        break;
+    }
+    case QUERY_SEVERITY:
+    {
+        memset(rows, 0, LOG_BITMAP_WORDS * sizeof(u64));
+        const log_bitmap_set_t& severity_rows = segment.severity_rows;
+        for (size_t b = 0; b < severity_rows.values.size(); ++b)
+        {
+            if ((node.severities >> severity_rows.values[b]) & 1)
+                log_bitmap_or(severity_rows.bitmaps[b], rows);
+        }
+        break;
+    }
+    case QUERY_TIME:
+        memset(rows, 0, LOG_BITMAP_WORDS * sizeof(u64));
+        for (u32 i = 0; i < segment.count; ++i)
+        {
+            const u64 timestamp = segment.timestamps[i];
+            rows[i >> 6] |= (u64)(timestamp >= node.time_min && timestamp <= node.time_max) << (i & 63);
+        }
+        break;
+    case QUERY_NOT:
+    {
+        // Only an exact mask can be inverted, otherwise every row has to be verified
+        fill_rows(rows, segment.count);
+        if (query.nodes[node.children[0]].exact)
+        {
+            std::vector<u64> child(LOG_BITMAP_WORDS);
+            node_rows(query, node.children[0], segment, child.data());
+            for (u32 w = 0; w < LOG_BITMAP_WORDS; ++w)
+                rows[w] &= ~child[w];
+        }
+        break;
+    }
+    case QUERY_AND:
+    case QUERY_OR:
+    {
+        const bool is_and = node.op == QUERY_AND;
+        if (is_and)
+            fill_rows(rows, segment.count);
+        else
+            memset(rows, 0, LOG_BITMAP_WORDS * sizeof(u64));
+
+        std::vector<u64> child(LOG_BITMAP_WORDS);
+        for (size_t c = 0; c < node.children.size(); ++c)
+        {
+            node_rows(query, node.children[c], segment, child.data());
+            for (u32 w = 0; w < LOG_BITMAP_WORDS; ++w)
+                rows[w] = is_and ? rows[w] & child[w] : rows[w] | child[w];
+        }
+        break;
+    }
+    }
+}
+//********************************************************************************************
+void log_query_rows(const log_query_t& query, const log_segment_t& segment, u64* rows)
+{
+    if (query.nodes.empty())
+    {
+        memset(rows, 0, LOG_BITMAP_WORDS * sizeof(u64));
+        return;
+    }
+
+    std::vector<u64> candidates(LOG_BITMAP_WORDS);
+    node_rows(query, query.root, segment, candidates.data());
+    for (u32 w = 0; w < LOG_BITMAP_WORDS; ++w)
+        rows[w] &= candidates[w];
+}
+//********************************************************************************************
+static bool match_node(const log_query_t& query, u32 id, const log_segment_t& segment, const char* text, u32 index)
+{
+    const log_query_node_t& node = query.nodes[id];
+    switch (node.op)
+    {
+    case QUERY_TEXT:
+    {
+        const char* content = text + segment.content_offsets[index];
+        const u32 length = segment.content_lengths[index];
+        if (node.fuzzy)
+            return fuzzy_find(*node.fuzzy, content, length);
+        if (query.ignore_case)
+            return scan_find_text_folded(content, length, node.text.data(), node.text.length()) != NULL;
+        return scan_find_text(content, length, node.text.data(), node.text.length()) != NULL;
+    }
+    case QUERY_REGEX:
+    {
+        // Runs on pool workers where an escaping exception ends the program, a row the
+        // regex is too complex for does not match
+        const char* content = text + segment.content_offsets[index];
+        try
+        {
+            return std::regex_search(content, content + segment.content_lengths[index], *node.regex);
+        }
+        catch (const std::regex_error&)
+        {
+            return false;
+        }
+    }
+    case QUERY_ORIGIN:
+    {
+        const u16 origin = segment.origins[index];
+        return origin < node.origin_matches.size() && node.origin_matches[origin];
+    }
+    case QUERY_SEVERITY:
+        return (node.severities >> (segment.severities[index] & 7)) & 1;
+    case QUERY_TIME:
+        return segment.timestamps[index] >= node.time_min && segment.timestamps[index] <= node.time_max;
+    case QUERY_NOT:
+        return !match_node(query, node.children[0], segment, text, index);
+    case QUERY_AND:
+        for (size_t c = 0; c < node.children.size(); ++c)
+        {
+            if (!match_node(query, node.children[c], segment, text, index))
+                return false;
+        }
+        return true;
+    case QUERY_OR:
+        for (size_t c = 0; c < node.children.size(); ++c)
+        {
+            if (match_node(query, node.children[c], segment, text, index))
+                return true;
+        }
+        return false;
+    }
+    return false;
+}
+//********************************************************************************************
+bool log_query_match(const log_query_t& query, const log_segment_t& segment, const char* text, u32 index)
+{
+    if (query.nodes.empty())
+        return false;
+
+    // Rows come from log_query_rows, which already applied every exact operand of a
+    // top level AND, leaving just the content predicates to run
+    const log_query_node_t& root = query.nodes[query.root];
+    if (root.exact)
+        return true;
+    if (root.op != QUERY_AND)
+        return match_node(query, query.root, segment, text, index);
+
+    for (size_t c = 0; c < root.children.size(); ++c)
+    {
+        if (!query.nodes[root.children[c]].exact && !match_node(query, root.children[c], segment, text, index))
+            return false;
+    }
+    return true;
+}
+//********************************************************************************************
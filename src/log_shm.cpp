@@ -0,0 +1,441 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+#include <chrono>
+#include <errno.h>
+#include <new>
+#include <stdio.h>
+#include <string.h>
+// INTERNAL INCLUDES
+#include "log_shm.h"
+
+static_assert(sizeof(log_shm_header_t) <= LOG_SHM_DATA_OFFSET, "shared header overlaps the ring");
+
+//********************************************************************************************
+static u64 record_size(u64 length)
+{
+    return (sizeof(log_shm_record_t) + length + 7) & ~(u64)7;
+}
+//********************************************************************************************
+// The wake up object is optional, without it the reader falls back to LOG_SHM_IDLE_WAIT_MS
+static void open_ready(log_shm_t& shm, const char* name, bool create)
+{
+    char ready_name[128];
+    snprintf(ready_name, sizeof(ready_name), "%s_ready", name);
+#if defined(_WIN32)
+    if (create)
+        shm.ready = CreateEventA(NULL, FALSE, FALSE, ready_name);
+    else
+        shm.ready = OpenEventA(EVENT_MODIFY_STATE, FALSE, ready_name);
+#else
+    sem_t* ready = sem_open(ready_name, create ? O_CREAT : 0, 0600, 0);
+    shm.ready = ready == SEM_FAILED ? NULL : ready;
+#endif
+}
+//********************************************************************************************
+static void close_ready(log_shm_t& shm)
+{
+    if (!shm.ready)
+        return;
+#if defined(_WIN32)
+    CloseHandle(shm.ready);
+#else
+    sem_close(shm.ready);
+    if (shm.owner)
+    {
+        char ready_name[128];
+        snprintf(ready_name, sizeof(ready_name), "%s_ready", shm.name);
+        sem_unlink(ready_name);
+    }
+#endif
+    shm.ready = NULL;
+}
+//********************************************************************************************
+static void signal_ready(log_shm_t& shm)
+{
+    if (!shm.ready)
+        return;
+#if defined(_WIN32)
+    SetEvent(shm.ready);
+#else
+    sem_post(shm.ready);
+#endif
+}
+//********************************************************************************************
+static void wait_ready(log_shm_t& shm, u32 milliseconds)
+{
+    if (!shm.ready)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+        return;
+    }
+#if defined(_WIN32)
+    WaitForSingleObject(shm.ready, milliseconds);
+#else
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += milliseconds / 1000;
+    deadline.tv_nsec += (long)(milliseconds % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+    while (sem_timedwait(shm.ready, &deadline) != 0 && errno == EINTR)
+    {
+    }
+#endif
+}
+//********************************************************************************************
+static bool map_region(log_shm_t& shm, const char* name, size_t size, bool create)
+{
+    shm.header = NULL;
+    shm.data = NULL;
+    shm.mapping_size = size;
+    shm.owner = false;
+
+#if defined(_WIN32)
+    if (create)
+    {
+        // The ring has one consumer, a second bSpy must not attach to it as well
+        char owner_name[128];
+        snprintf(owner_name, sizeof(owner_name), "%s_owner", name);
+        shm.owner_lock = CreateMutexA(NULL, FALSE, owner_name);
+        DWORD wait = shm.owner_lock ? WaitForSingleObject(shm.owner_lock, 0) : WAIT_FAILED;
+        if (wait != WAIT_OBJECT_0 && wait != WAIT_ABANDONED)
+        {
+            if (shm.owner_lock)
+                CloseHandle(shm.owner_lock);
+            shm.owner_lock = NULL;
+            return false;
+        }
+
+        shm.mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+            (DWORD)((u64)size >> 32), (DWORD)size, name);
+    }
+    else
+    {
+        shm.mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name);
+    }
+    void* view = shm.mapping ? MapViewOfFile(shm.mapping, FILE_MAP_ALL_ACCESS, 0, 0, size) : NULL;
+    if (!view)
+    {
+        if (shm.mapping)
+            CloseHandle(shm.mapping);
+        shm.mapping = NULL;
+        if (shm.owner_lock)
+        {
+            ReleaseMutex(shm.owner_lock);
+            CloseHandle(shm.owner_lock);
+            shm.owner_lock = NULL;
+        }
+        return false;
+    }
+#else
+    snprintf(shm.name, sizeof(shm.name), "%s", name);
+    shm.fd = shm_open(name, create ? (O_CREAT | O_RDWR) : O_RDWR, 0600);
+    if (shm.fd < 0)
+        return false;
+
+    // The ring has one consumer, a second bSpy must not attach to it as well. The lock
+    // goes away with its process, so a region left by a crash is taken over.
+    if (create && flock(shm.fd, LOCK_EX | LOCK_NB) != 0)
+    {
+        close(shm.fd);
+        shm.fd = -1;
+        return false;
+    }
+
+    if (create && ftruncate(shm.fd, (off_t)size) != 0)
+    {
+        close(shm.fd);
+        shm.fd = -1;
+        return false;
+    }
+
+    if (!create)
+    {
+        // The producer does not know the capacity up front, take it from the object
+        struct stat st;
+        if (fstat(shm.fd, &st) != 0 || (size_t)st.st_size < LOG_SHM_DATA_OFFSET)
+        {
+            close(shm.fd);
+            shm.fd = -1;
+            return false;
+        }
+        size = (size_t)st.st_size;
+        shm.mapping_size = size;
+    }
+
+    void* view = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, shm.fd, 0);
+    if (view == MAP_FAILED)
+    {
+        close(shm.fd);
+        shm.fd = -1;
+        return false;
+    }
+#endif
+
+    shm.header = (log_shm_header_t*)view;
+    shm.data = (char*)view + LOG_SHM_DATA_OFFSET;
+    shm.owner = create;
+    return true;
+}
+//********************************************************************************************
+bool log_shm_create(log_shm_t& shm, const char* name, u64 capacity)
+{
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+        return false;
+
+    if (!map_region(shm, name, (size_t)(LOG_SHM_DATA_OFFSET + capacity), true))
+        return false;
+
+    log_shm_header_t* header = shm.header;
+    if (header->magic == LOG_SHM_MAGIC &&
+        header->version == LOG_SHM_VERSION &&
+        header->capacity == capacity)
+    {
+        // Region survived from a previous session that a producer still holds open,
+        // keep its indices so neither side gets out of sync
+        header->reader_waiting.store(0);
+        open_ready(shm, name, true);
+        return true;
+    }
+
+    new (header) log_shm_header_t();
+    header->capacity = capacity;
+    header->head.store(0);
+    header->tail.store(0);
+    header->dropped.store(0);
+    header->reader_waiting.store(0);
+    header->version = LOG_SHM_VERSION;
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = LOG_SHM_MAGIC;
+    open_ready(shm, name, true);
+    return true;
+}
+//********************************************************************************************
+bool log_shm_open(log_shm_t& shm, const char* name)
+{
+#if defined(_WIN32)
+    // Map the header first to learn the capacity, then remap the whole region
+    if (!map_region(shm, name, LOG_SHM_DATA_OFFSET, false))
+        return false;
+    u64 capacity = shm.header->capacity;
+    bool valid = shm.header->magic == LOG_SHM_MAGIC && shm.header->version == LOG_SHM_VERSION;
+    log_shm_close(shm);
+    if (!valid || !map_region(shm, name, (size_t)(LOG_SHM_DATA_OFFSET + capacity), false))
+        return false;
+#else
+    if (!map_region(shm, name, 0, false))
+        return false;
+#endif
+
+    const log_shm_header_t* header = shm.header;
+    if (header->magic != LOG_SHM_MAGIC ||
+        header->version != LOG_SHM_VERSION ||
+        LOG_SHM_DATA_OFFSET + header->capacity > shm.mapping_size)
+    {
+        log_shm_close(shm);
+        return false;
+    }
+    open_ready(shm, name, false);
+    return true;
+}
+//********************************************************************************************
+void log_shm_close(log_shm_t& shm)
+{
+    log_shm_stop_reader(shm);
+    close_ready(shm);
+
+#if defined(_WIN32)
+    if (shm.header)
+        UnmapViewOfFile(shm.header);
+    if (shm.mapping)
+        CloseHandle(shm.mapping);
+    shm.mapping = NULL;
+    if (shm.owner_lock)
+    {
+        ReleaseMutex(shm.owner_lock);
+        CloseHandle(shm.owner_lock);
+    }
+    shm.owner_lock = NULL;
+#else
+    if (shm.header)
+        munmap(shm.header, shm.mapping_size);
+    // Only the reader that created the region removes its name, closing drops the lock
+    if (shm.owner && shm.header)
+        shm_unlink(shm.name);
+    if (shm.fd >= 0)
+        close(shm.fd);
+    shm.fd = -1;
+#endif
+
+    shm.header = NULL;
+    shm.data = NULL;
+    shm.owner = false;
+}
+//********************************************************************************************
+bool log_shm_write(log_shm_t& shm, log_ingest_kind_e kind, const void* data, size_t length)
+{
+    log_shm_header_t* header = shm.header;
+    const u64 capacity = header->capacity;
+    const u64 needed = record_size(length);
+
+    u64 head = header->head.load(std::memory_order_relaxed);
+    u64 free_space = capacity - (head - header->tail.load(std::memory_order_acquire));
+    u64 pos = head & (capacity - 1);
+    u64 contiguous = capacity - pos;
+    u64 padding = contiguous < needed ? contiguous : 0;
+
+    if (needed > capacity / 2 || free_space < padding + needed)
+    {
+        // Never block the producer, bSpy shows the count as lost entries
+        header->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (padding)
+    {
+        log_shm_record_t* wrap = (log_shm_record_t*)(shm.data + pos);
+        wrap->length = (u32)(padding - sizeof(log_shm_record_t));
+        wrap->kind = LOG_INGEST_WRAP;
+        head += padding;
+        pos = 0;
+    }
+
+    log_shm_record_t* record = (log_shm_record_t*)(shm.data + pos);
+    record->length = (u32)length;
+    record->kind = kind;
+    memcpy(record + 1, data, length);
+    header->head.store(head + needed, std::memory_order_release);
+
+    // Only a sleeping reader needs the system call, a busy one finds the record by itself
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (header->reader_waiting.load(std::memory_order_relaxed))
+        signal_ready(shm);
+    return true;
+}
+//********************************************************************************************
+static void reader_main(log_shm_t* shm, log_ingest_t* ingest)
+{
+    log_shm_header_t* header = shm->header;
+    const char* data = shm->data;
+    const u64 capacity = header->capacity;
+    log_batch_t* batch = NULL;
+    u32 idle = 0;
+
+    while (shm->running.load(std::memory_order_relaxed))
+    {
+        u64 tail = header->tail.load(std::memory_order_relaxed);
+        u64 head = header->head.load(std::memory_order_acquire);
+
+        if (tail == head)
+        {
+            if (batch)
+            {
+                log_ingest_publish(*ingest, batch);
+                batch = NULL;
+            }
+
+            // Bursts usually continue right away, after that sleep until a producer signals
+            if (++idle < 64)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            header->reader_waiting.store(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (header->head.load(std::memory_order_acquire) == tail && shm->running.load())
+                wait_ready(*shm, LOG_SHM_IDLE_WAIT_MS);
+            header->reader_waiting.store(0);
+            continue;
+        }
+        idle = 0;
+
+        while (tail != head)
+        {
+            log_shm_record_t record = *(const log_shm_record_t*)(data + (tail & (capacity - 1)));
+            u64 size = record_size(record.length);
+
+            // The producer lives in another process, do not trust its framing
+            if (size > head - tail || size > capacity - (tail & (capacity - 1)))
+            {
+                tail = head;
+                break;
+            }
+
+            if (record.kind != LOG_INGEST_WRAP)
+            {
+                if (!batch)
+                    batch = log_ingest_acquire_batch(*ingest);
+                log_ingest_parse(*batch, record.kind,
+                    data + (tail & (capacity - 1)) + sizeof(log_shm_record_t), record.length);
+            }
+
+            tail += size;
+            header->tail.store(tail, std::memory_order_release);
+
+            if (batch && batch->count >= LOG_INGEST_BATCH_ENTRIES)
+            {
+                log_ingest_publish(*ingest, batch);
+                batch = NULL;
+            }
+        }
+        header->tail.store(tail, std::memory_order_release);
+    }
+
+    if (batch)
+        log_ingest_publish(*ingest, batch);
+}
+//********************************************************************************************
+void log_shm_start_reader(log_shm_t& shm, log_ingest_t& ingest)
+{
+    shm.running.store(true);
+    shm.reader = std::thread(reader_main, &shm, &ingest);
+}
+//********************************************************************************************
+void log_shm_stop_reader(log_shm_t& shm)
+{
+    if (!shm.reader.joinable())
+        return;
+
+    shm.running.store(false);
+    signal_ready(shm);
+    shm.reader.join();
+}
+//********************************************************************************************
+u64 log_shm_dropped(const log_shm_t& shm)
+{
+    return shm.header ? shm.header->dropped.load(std::memory_order_relaxed) : 0;
+}
+//********************************************************************************************
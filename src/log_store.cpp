@@ -0,0 +1,692 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#include <algorithm>
+#include <string.h>
+// INTERNAL INCLUDES
+#include "log_store.h"
+#include "lz_block.h"
+#include "text_scan.h"
+#include "thread_pool.h"
+
+#define ORIGIN_SLOT_EMPTY 0xFFFF
+
+//********************************************************************************************
+const char* severity_to_string(log_severity_e severity)
+{
+    switch (severity)
+    {
+    case INFO: return "INFO";
+    case WARN: return "WARN";
+    case FAIL: return "FAIL";
+    case SUCC: return "SUCC";
+    case CRIT: return "CRIT";
+    case DBUG: return "DBUG";
+    case TRCE: return "TRCE";
+    default: return "UNKN";
+    }
+}
+//********************************************************************************************
+static u32 hash_bytes(const char* data, size_t length)
+{
+    // FNV-1a
+    u32 hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i)
+    {
+        hash ^= (u8)data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+//********************************************************************************************
+static bool origin_equals(const std::string& name, const char* origin, size_t length)
+{
+    return name.length() == length && memcmp(name.data(), origin, length) == 0;
+}
+//********************************************************************************************
+static void rehash_origins(log_store_t& store, size_t slot_count)
+{
+    store.origin_slots.assign(slot_count, ORIGIN_SLOT_EMPTY);
+    const size_t mask = slot_count - 1;
+
+    for (size_t id = 0; id < store.origin_names.size(); ++id)
+    {
+        const std::string& name = store.origin_names[id];
+        size_t slot = hash_bytes(name.data(), name.length()) & mask;
+        while (store.origin_slots[slot] != ORIGIN_SLOT_EMPTY)
+            slot = (slot + 1) & mask;
+        store.origin_slots[slot] = (u16)id;
+    }
+}
+//********************************************************************************************
+u16 log_store_intern_origin(log_store_t& store, const char* origin, size_t length)
+{
+    if (length > LOG_ORIGIN_MAX_LENGTH)
+        length = LOG_ORIGIN_MAX_LENGTH;
+
+    // Consecutive entries usually come from the same origin
+    if (store.last_origin < store.origin_names.size() &&
+        origin_equals(store.origin_names[store.last_origin], origin, length))
+    {
+        return store.last_origin;
+    }
+
+    if (store.origin_slots.empty())
+        rehash_origins(store, 256);
+
+    const size_t mask = store.origin_slots.size() - 1;
+    size_t slot = hash_bytes(origin, length) & mask;
+    while (store.origin_slots[slot] != ORIGIN_SLOT_EMPTY)
+    {
+        u16 id = store.origin_slots[slot];
+        if (origin_equals(store.origin_names[id], origin, length))
+        {
+            store.last_origin = id;
+            return id;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    if (store.origin_names.size() >= LOG_ORIGIN_OVERFLOW)
+    {
+        // Table is full, fold every further origin into a shared placeholder
+        if (store.origin_names.size() == LOG_ORIGIN_OVERFLOW)
+            store.origin_names.push_back("<other>");
+        return LOG_ORIGIN_OVERFLOW;
+    }
+
+    u16 id = (u16)store.origin_names.size();
+    store.origin_names.emplace_back(origin, length);
+    store.origin_slots[slot] = id;
+    store.last_origin = id;
+
+    // Keep the load factor below one half
+    if (store.origin_names.size() * 2 > store.origin_slots.size())
+        rehash_origins(store, store.origin_slots.size() * 2);
+
+    return id;
+}
+//********************************************************************************************
+static void release_front(log_store_t& store)
+{
+    store.spare = std::move(store.segments.front());
+    store.segments.pop_front();
+    store.evicted_bytes = 0;
+
+    // Let go of a mapped file right away, saving over it is refused while it is mapped
+    if (store.spare.use_count() == 1)
+    {
+        store.spare->external_text = NULL;
+        store.spare->source.reset();
+    }
+}
+//********************************************************************************************
+static log_segment_t* new_segment(log_store_t& store, u64 first_id)
+{
+    // Every entry was evicted while this was the newest segment, it goes before the next
+    if (!store.segments.empty() && store.first_id == store.next_id)
+        release_front(store);
+
+    // A released segment can only be reused once no snapshot reads it anymore
+    log_segment_t* segment = NULL;
+    if (store.spare && store.spare.use_count() == 1)
+        segment = store.spare.get();
+    else
+        store.spare.reset();
+
+    if (segment)
+    {
+        // Reuse the columns of a released segment, keeping their capacity
+        segment->timestamps.clear();
+        segment->severities.clear();
+        segment->origins.clear();
+        segment->content_offsets.clear();
+        segment->content_lengths.clear();
+        segment->text.clear();
+        segment->external_text = NULL;
+        segment->source.reset();
+        segment->packed.clear();
+        segment->text_bytes = 0;
+        segment->touched = false;
+        segment->sealed = false;
+        segment->trigram_keys.clear();
+        segment->indexed = false;
+        log_bitmap_set_clear(segment->severity_rows);
+        log_bitmap_set_clear(segment->origin_rows);
+        segment->links.clear();
+    }
+    else
+    {
+        store.spare.reset(new log_segment_t());
+        segment = store.spare.get();
+    }
+    segment->first_id = first_id;
+    segment->count = 0;
+    store.segments.push_back(std::move(store.spare));
+    return segment;
+}
+//********************************************************************************************
+static bool over_retention(const log_store_t& store)
+{
+    const log_retention_t& retention = store.retention;
+    if (store.first_id >= store.next_id)
+        return false;
+
+    if (retention.max_entries && store.next_id - store.first_id > retention.max_entries)
+        return true;
+    // The newest segment is never released, evicting from it only lowers the entry bytes
+    const u64 bytes = store.segments.size() > 1 ? log_store_held_bytes(store) : store.retained_bytes;
+    if (retention.max_bytes && bytes > retention.max_bytes)
+        return true;
+    if (retention.max_age)
+    {
+        const log_segment_t& front = *store.segments.front();
+        u64 oldest = front.timestamps[store.first_id - front.first_id];
+        if (oldest + retention.max_age * LOG_NS_PER_SECOND < store.newest_timestamp)
+            return true;
+    }
+    return false;
+}
+//********************************************************************************************
+void log_store_evict_front(log_store_t& store)
+{
+    if (store.first_id >= store.next_id)
+        return;
+
+    log_segment_t* front = store.segments.front().get();
+    u32 index = (u32)(store.first_id - front->first_id);
+    const u64 bytes = front->content_lengths[index] + LOG_ENTRY_OVERHEAD;
+    store.retained_bytes -= bytes;
+    store.evicted_bytes += bytes;
+    store.first_id++;
+    store.dropped++;
+
+    if (store.first_id == front->first_id + front->count && front != store.segments.back().get())
+        release_front(store);
+}
+//********************************************************************************************
+void log_store_set_retention(log_store_t& store, const log_retention_t& retention)
+{
+    store.retention = retention;
+    while (over_retention(store))
+        log_store_evict_front(store);
+}
+//********************************************************************************************
+// Records the links in the content of the entry being appended, so drawing it does not
+// have to look for them every frame
+static void find_links(log_segment_t* segment, const char* content, u32 length)
+{
+    const char* p = content;
+    const char* end = content + length;
+    while (p < end)
+    {
+        const char* http = scan_find_text(p, end - p, "http", 4);
+        if (!http)
+            break;
+
+        const char* scheme_end = http + 4;
+        if (scheme_end < end && *scheme_end == 's')
+            scheme_end++;
+        if (end - scheme_end < 3 || memcmp(scheme_end, "://", 3) != 0)
+        {
+            p = http + 4;
+            continue;
+        }
+
+        const char* link_end = scan_find_any(scheme_end + 3, end, ' ', '\t', '\n', '\r');
+        log_link_t link;
+        link.row = segment->count;
+        link.begin = (u32)(http - content);
+        link.length = (u32)(link_end - http);
+        segment->links.push_back(link);
+        p = link_end;
+    }
+}
+//********************************************************************************************
+static u64 push_entry(
+    log_store_t& store,
+    log_segment_t* segment,
+    u64 timestamp,
+    log_severity_e severity,
+    u16 origin_id,
+    const char* content,
+    u32 content_offset,
+    u32 content_length)
+{
+    find_links(segment, content, content_length);
+    segment->timestamps.push_back(timestamp);
+    segment->severities.push_back((u8)severity);
+    segment->origins.push_back(origin_id);
+    segment->content_offsets.push_back(content_offset);
+    segment->content_lengths.push_back(content_length);
+    log_bitmap_set_add(segment->severity_rows, (u8)severity & 7, (u16)segment->count);
+    log_bitmap_set_add(segment->origin_rows, origin_id, (u16)segment->count);
+    segment->count++;
+
+    store.retained_bytes += content_length + LOG_ENTRY_OVERHEAD;
+    if (timestamp > store.newest_timestamp)
+        store.newest_timestamp = timestamp;
+
+    u64 id = store.next_id++;
+    while (over_retention(store))
+        log_store_evict_front(store);
+
+    return id;
+}
+//********************************************************************************************
+u64 log_store_append(
+    log_store_t& store,
+    u64 timestamp,
+    log_severity_e severity,
+    const char* origin,
+    size_t origin_length,
+    const char* content,
+    size_t content_length)
+{
+    u16 origin_id = log_store_intern_origin(store, origin, origin_length);
+    return log_store_append_interned(store, timestamp, severity, origin_id, content, content_length);
+}
+//********************************************************************************************
+u64 log_store_append_interned(
+    log_store_t& store,
+    u64 timestamp,
+    log_severity_e severity,
+    u16 origin,
+    const char* content,
+    size_t content_length)
+{
+    if (content_length > 0xFFFFFFFFu)
+        content_length = 0xFFFFFFFFu;
+
+    log_segment_t* segment = store.segments.empty() ? NULL : store.segments.back().get();
+    if (!segment ||
+        segment->count >= LOG_SEGMENT_CAPACITY ||
+        segment->sealed ||
+        segment->external_text ||
+        segment->text.size() + content_length > 0xFFFFFFFFu)
+    {
+        segment = new_segment(store, store.next_id);
+    }
+
+    u32 offset = (u32)segment->text.size();
+    segment->text.insert(segment->text.end(), content, content + content_length);
+
+    return push_entry(store, segment, timestamp, severity, origin, content, offset, (u32)content_length);
+}
+//********************************************************************************************
+u64 log_store_append_external(
+    log_store_t& store,
+    const std::shared_ptr<const void>& source,
+    u64 timestamp,
+    log_severity_e severity,
+    u16 origin,
+    const char* content,
+    size_t content_length)
+{
+    if (content_length > 0xFFFFFFFFu)
+        content_length = 0xFFFFFFFFu;
+
+    // Content stays where it is, the segment only records where to find it
+    log_segment_t* segment = store.segments.empty() ? NULL : store.segments.back().get();
+    if (!segment ||
+        segment->count >= LOG_SEGMENT_CAPACITY ||
+        segment->sealed ||
+        segment->source != source ||
+        content < segment->external_text ||
+        (u64)(content - segment->external_text) + content_length > 0xFFFFFFFFu)
+    {
+        segment = new_segment(store, store.next_id);
+        segment->source = source;
+        segment->external_text = content;
+    }
+
+    return push_entry(store, segment, timestamp, severity, origin, content,
+        (u32)(content - segment->external_text), (u32)content_length);
+}
+//********************************************************************************************
+void log_store_append_batch(log_store_t& store, const log_batch_t& batch)
+{
+    const char* text = batch.text.data();
+    for (u32 i = 0; i < batch.count; ++i)
+    {
+        log_store_append(store,
+            batch.timestamps[i],
+            (log_severity_e)batch.severities[i],
+            text + batch.origin_offsets[i],
+            batch.origin_lengths[i],
+            text + batch.content_offsets[i],
+            batch.content_lengths[i]);
+    }
+}
+//********************************************************************************************
+void log_store_clear(log_store_t& store)
+{
+    store.segments.clear();
+    // Origins are interned again from the next entry on, the ids of the old ones go stale
+    store.origin_names.clear();
+    store.origin_slots.clear();
+    store.last_origin = 0;
+    store.first_id = store.next_id;
+    store.generation++;
+    store.retained_bytes = 0;
+    store.evicted_bytes = 0;
+    store.newest_timestamp = 0;
+    store.dropped = 0;
+}
+//********************************************************************************************
+void log_store_replace(log_store_t& store, log_store_t& loaded)
+{
+    log_store_clear(store);
+    const u64 base = store.next_id - loaded.first_id;
+    for (size_t s = 0; s < loaded.segments.size(); ++s)
+        loaded.segments[s]->first_id += base;
+
+    store.segments.swap(loaded.segments);
+    store.origin_names.swap(loaded.origin_names);
+    store.origin_slots.swap(loaded.origin_slots);
+    store.last_origin = loaded.last_origin;
+    store.first_id = loaded.first_id + base;
+    store.next_id = loaded.next_id + base;
+    store.retained_bytes = loaded.retained_bytes;
+    store.evicted_bytes = loaded.evicted_bytes;
+    store.newest_timestamp = loaded.newest_timestamp;
+    store.dropped = loaded.dropped;
+    log_store_clear(loaded);
+}
+//********************************************************************************************
+void log_segment_unpack(const log_segment_t& segment)
+{
+    std::shared_ptr<std::vector<char>> text = std::make_shared<std::vector<char>>(segment.text_bytes);
+    if (!lz_decompress(segment.packed.data(), segment.packed.size(), text->data(), text->size()))
+        memset(text->data(), '?', text->size()); // never expected, keep offsets in bounds
+
+    segment.source = text;
+    segment.external_text = text->data();
+}
+//********************************************************************************************
+static void pack_segment_text(std::shared_ptr<log_pack_job_t> job)
+{
+    const std::vector<char>& text = *job->text;
+    job->packed.resize(lz_compress_bound(text.size()));
+    size_t size = lz_compress(text.data(), text.size(), job->packed.data(), job->packed.size());
+
+    // Not worth it when the content hardly shrinks
+    if (size == 0 || size > text.size() / 4 * 3)
+        size = 0;
+    job->packed.resize(size);
+    job->packed.shrink_to_fit();
+    job->done.store(true, std::memory_order_release);
+}
+//********************************************************************************************
+const char* log_segment_read_text(const log_segment_t& segment, std::vector<char>& scratch)
+{
+    if (segment.packed.empty())
+        return segment.external_text ? segment.external_text : segment.text.data();
+
+    scratch.resize(segment.text_bytes);
+    if (!lz_decompress(segment.packed.data(), segment.packed.size(), scratch.data(), scratch.size()))
+        memset(scratch.data(), '?', scratch.size());
+    return scratch.data();
+}
+//********************************************************************************************
+void log_store_snapshot(log_store_t& store, log_snapshot_t& snapshot)
+{
+    // Seal the newest segment, appends continue in a fresh one
+    if (!store.segments.empty())
+        store.segments.back()->sealed = true;
+
+    snapshot.segments.assign(store.segments.begin(), store.segments.end());
+    snapshot.origin_names = store.origin_names;
+    snapshot.first_id = store.first_id;
+    snapshot.next_id = store.next_id;
+    snapshot.filtered = false;
+    snapshot.ids.clear();
+}
+//********************************************************************************************
+void log_snapshot_cursor_init(log_snapshot_cursor_t& cursor, const log_snapshot_t& snapshot)
+{
+    cursor.snapshot = &snapshot;
+    cursor.segment = 0;
+    cursor.index = 0;
+    cursor.position = 0;
+    cursor.text = NULL;
+}
+//********************************************************************************************
+bool log_snapshot_next(log_snapshot_cursor_t& cursor, const log_segment_t*& segment, u32& index)
+{
+    const log_snapshot_t& snapshot = *cursor.snapshot;
+    while (cursor.segment < snapshot.segments.size())
+    {
+        const log_segment_t& current = *snapshot.segments[cursor.segment];
+        if (!cursor.text)
+        {
+            cursor.text = log_segment_read_text(current, cursor.scratch);
+            cursor.index = snapshot.first_id > current.first_id ? (u32)(snapshot.first_id - current.first_id) : 0;
+        }
+
+        if (snapshot.filtered)
+        {
+            if (cursor.position >= snapshot.ids.size())
+                return false;
+
+            u64 id = snapshot.ids[cursor.position];
+            if (id < current.first_id + cursor.index)
+            {
+                cursor.position++; // evicted before the snapshot was taken
+                continue;
+            }
+            if (id < current.first_id + current.count)
+            {
+                cursor.position++;
+                segment = &current;
+                index = (u32)(id - current.first_id);
+                return true;
+            }
+        }
+        else if (cursor.index < current.count)
+        {
+            segment = &current;
+            index = cursor.index++;
+            return true;
+        }
+
+        cursor.segment++;
+        cursor.text = NULL;
+    }
+    return false;
+}
+//********************************************************************************************
+static bool install_pack_job(log_store_t& store, log_pack_job_t& job)
+{
+    for (size_t s = 0; s < store.segments.size(); ++s)
+    {
+        log_segment_t& segment = *store.segments[s];
+        if (segment.first_id != job.first_id || segment.source != job.text)
+            continue;
+        if (store.segments[s].use_count() > 1)
+            return false; // a snapshot reads the segment, install it later
+        if (!job.packed.empty())
+        {
+            segment.packed.swap(job.packed);
+            segment.text_bytes = (u32)job.text->size();
+        }
+        break;
+    }
+    return true;
+}
+//********************************************************************************************
+u32 log_store_compact(log_store_t& store)
+{
+    // Install finished jobs whose segment is still around
+    u32 installed = 0;
+    for (size_t j = 0; j < store.pack_jobs.size();)
+    {
+        log_pack_job_t& job = *store.pack_jobs[j];
+        if (job.done.load(std::memory_order_acquire) && install_pack_job(store, job))
+        {
+            store.pack_jobs.erase(store.pack_jobs.begin() + j);
+            installed++;
+        }
+        else
+        {
+            ++j;
+        }
+    }
+
+    // Release unpacked copies that were not read since the last pass
+    for (size_t s = 0; s < store.segments.size(); ++s)
+    {
+        log_segment_t& segment = *store.segments[s];
+        if (segment.packed.empty() || !segment.external_text || store.segments[s].use_count() > 1)
+            continue;
+        if (segment.touched)
+        {
+            segment.touched = false;
+        }
+        else
+        {
+            segment.external_text = NULL;
+            segment.source.reset();
+        }
+    }
+
+    if (!store.compress_cold)
+        return installed;
+
+    // Hand the arena of cold segments to the pool. The segment keeps reading it as
+    // external text until the compressed form is installed.
+    const size_t cold = store.segments.size() > LOG_HOT_SEGMENTS ? store.segments.size() - LOG_HOT_SEGMENTS : 0;
+    for (size_t s = 0; s < cold && store.pack_jobs.size() < LOG_PACK_JOBS; ++s)
+    {
+        log_segment_t& segment = *store.segments[s];
+        if (segment.external_text || !segment.packed.empty() || segment.text.empty() ||
+            store.segments[s].use_count() > 1)
+        {
+            continue;
+        }
+
+        std::shared_ptr<std::vector<char>> text = std::make_shared<std::vector<char>>();
+        text->swap(segment.text);
+        segment.source = text;
+        segment.external_text = text->data();
+
+        std::shared_ptr<log_pack_job_t> job = std::make_shared<log_pack_job_t>();
+        job->first_id = segment.first_id;
+        job->text = text;
+        job->done.store(false, std::memory_order_relaxed);
+        store.pack_jobs.push_back(job);
+        thread_pool_submit(thread_pool_shared(), [job]() { pack_segment_text(job); });
+    }
+    return installed;
+}
+//********************************************************************************************
+size_t log_store_segment_index(const log_store_t& store, u64 id)
+{
+    // Segments are ordered by first_id, find the last one starting at or before id
+    size_t lo = 0;
+    size_t hi = store.segments.size();
+    while (hi - lo > 1)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (store.segments[mid]->first_id <= id)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+//********************************************************************************************
+const log_segment_t* log_store_find_segment(const log_store_t& store, u64 id)
+{
+    if (id < store.first_id || id >= store.next_id)
+        return NULL;
+
+    return store.segments[log_store_segment_index(store, id)].get();
+}
+//********************************************************************************************
+bool log_store_get(const log_store_t& store, u64 id, log_entry_ref_t& entry)
+{
+    const log_segment_t* segment = log_store_find_segment(store, id);
+    if (!segment)
+        return false;
+
+    u32 index = (u32)(id - segment->first_id);
+    entry.id = id;
+    entry.timestamp = segment->timestamps[index];
+    entry.severity = (log_severity_e)segment->severities[index];
+    entry.origin = segment->origins[index];
+    entry.content = log_segment_content(*segment, index);
+    entry.content_length = segment->content_lengths[index];
+
+    // Rows are appended in order, so the links of one entry are next to each other
+    entry.links = NULL;
+    entry.link_count = 0;
+    if (!segment->links.empty())
+    {
+        const log_link_t* begin = segment->links.data();
+        const log_link_t* end = begin + segment->links.size();
+        const log_link_t* first = std::lower_bound(begin, end, index,
+            [](const log_link_t& link, u32 row) { return link.row < row; });
+        const log_link_t* last = first;
+        while (last < end && last->row == index)
+            ++last;
+        if (last != first)
+        {
+            entry.links = first;
+            entry.link_count = (u32)(last - first);
+        }
+    }
+    return true;
+}
+//********************************************************************************************
+void log_batch_add(
+    log_batch_t& batch,
+    u64 timestamp,
+    log_severity_e severity,
+    const char* origin,
+    size_t origin_length,
+    const char* content,
+    size_t content_length)
+{
+    batch.timestamps.push_back(timestamp);
+    batch.severities.push_back((u8)severity);
+    batch.origin_offsets.push_back((u32)batch.text.size());
+    batch.origin_lengths.push_back((u32)origin_length);
+    batch.text.insert(batch.text.end(), origin, origin + origin_length);
+    batch.content_offsets.push_back((u32)batch.text.size());
+    batch.content_lengths.push_back((u32)content_length);
+    batch.text.insert(batch.text.end(), content, content + content_length);
+    batch.count++;
+}
+//********************************************************************************************
+void log_batch_clear(log_batch_t& batch)
+{
+    batch.count = 0;
+    batch.timestamps.clear();
+    batch.severities.clear();
+    batch.origin_offsets.clear();
+    batch.origin_lengths.clear();
+    batch.content_offsets.clear();
+    batch.content_lengths.clear();
+    batch.text.clear();
+}
+//********************************************************************************************
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#include <string.h>
+// INTERNAL INCLUDES
+#include "lz_block.h"
+
+#define LZ_MIN_MATCH 4
+#define LZ_HASH_BITS 14
+#define LZ_LAST_LITERALS 5      // the format ends every block with at least this many literals
+#define LZ_MATCH_LIMIT 12       // no match may start within this many bytes of the end
+#define LZ_MAX_OFFSET 65535
+
+//********************************************************************************************
+static u32 read32(const char* p)
+{
+    u32 value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+//********************************************************************************************
+static u32 hash4(u32 sequence)
+{
+    return (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+//********************************************************************************************
+static char* write_length(char* op, size_t length)
+{
+    // Continuation bytes after a saturated token nibble
+    while (length >= 255)
+    {
+        *op++ = (char)255;
+        length -= 255;
+    }
+    *op++ = (char)length;
+    return op;
+}
+//********************************************************************************************
+static char* write_literals(char* op, const char* literals, size_t length, u8 match_nibble)
+{
+    char* token = op++;
+    if (length >= 15)
+    {
+        *token = (char)((15 << 4) | match_nibble);
+        op = write_length(op, length - 15);
+    }
+    else
+    {
+        *token = (char)((length << 4) | match_nibble);
+    }
+    memcpy(op, literals, length);
+    return op + length;
+}
+//********************************************************************************************
+size_t lz_compress(const char* src, size_t size, char* dst, size_t capacity)
+{
+    // With the bound reserved the loop never has to check for output space
+    if (capacity < lz_compress_bound(size) || size > 0xFFFFFFFFu)
+        return 0;
+
+    const char* ip = src;
+    const char* anchor = src;
+    const char* end = src + size;
+    char* op = dst;
+
+    if (size > LZ_MATCH_LIMIT)
+    {
+        u32 table[1 << LZ_HASH_BITS];
+        memset(table, 0, sizeof(table));
+
+        const char* match_limit = end - LZ_MATCH_LIMIT;
+        const char* extend_limit = end - LZ_LAST_LITERALS;
+        while (ip < match_limit)
+        {
+            u32 sequence = read32(ip);
+            u32 hash = hash4(sequence);
+            const char* ref = src + table[hash];
+            table[hash] = (u32)(ip - src);
+
+            if (ref >= ip || ip - ref > LZ_MAX_OFFSET || read32(ref) != sequence)
+            {
+                // Step faster through data that does not compress
+                ip += 1 + ((ip - anchor) >> 6);
+                continue;
+            }
+
+            while (ip > anchor && ref > src && ip[-1] == ref[-1])
+            {
+                ip--;
+                ref--;
+            }
+            const char* match_end = ip + LZ_MIN_MATCH;
+            const char* ref_end = ref + LZ_MIN_MATCH;
+            while (match_end < extend_limit && *match_end == *ref_end)
+            {
+                match_end++;
+                ref_end++;
+            }
+
+            size_t match_length = match_end - ip - LZ_MIN_MATCH;
+            u8 match_nibble = match_length >= 15 ? 15 : (u8)match_length;
+            op = write_literals(op, anchor, ip - anchor, match_nibble);
+
+            u32 offset = (u32)(ip - ref);
+            *op++ = (char)(offset & 0xFF);
+            *op++ = (char)(offset >> 8);
+            if (match_length >= 15)
+                op = write_length(op, match_length - 15);
+
+            ip = anchor = match_end;
+            if (ip < match_limit)
+                table[hash4(read32(ip - 2))] = (u32)(ip - 2 - src);
+        }
+    }
+
+    op = write_literals(op, anchor, end - anchor, 0);
+    return op - dst;
+}
+//********************************************************************************************
+static bool read_length(const u8*& ip, const u8* end, size_t& length)
+{
+    u8 byte;
+    do
+    {
+        if (ip >= end)
+            return false;
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+//********************************************************************************************
+bool lz_decompress(const char* src, size_t size, char* dst, size_t raw_size)
+{
+    const u8* ip = (const u8*)src;
+    const u8* end = ip + size;
+    char* op = dst;
+    char* out_end = dst + raw_size;
+
+    while (ip < end)
+    {
+        u32 token = *ip++;
+
+        size_t literal_length = token >> 4;
+        if (literal_length == 15 && !read_length(ip, end, literal_length))
+            return false;
+        if ((size_t)(end - ip) < literal_length || (size_t)(out_end - op) < literal_length)
+            return false;
+        memcpy(op, ip, literal_length);
+        op += literal_length;
+        ip += literal_length;
+
+        // The last sequence only has literals
+        if (ip == end)
+            break;
+
+        if (end - ip < 2)
+            return false;
+        size_t offset = ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - dst))
+            return false;
+
+        size_t match_length = token & 15;
+        if (match_length == 15 && !read_length(ip, end, match_length))
+            return false;
+        match_length += LZ_MIN_MATCH;
+        if ((size_t)(out_end - op) < match_length)
+            return false;
+
+        // Overlapping matches repeat the pattern, copy it in growing pieces
+        const char* ref = op - offset;
+        while (match_length > 0)
+        {
+            size_t n = (size_t)(op - ref) < match_length ? (size_t)(op - ref) : match_length;
+            memcpy(op, ref, n);
+            op += n;
+            match_length -= n;
+        }
+    }
+    return op == out_end;
+}
+//********************************************************************************************
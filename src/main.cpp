@@ -22,8 +22,12 @@
  // EXTERNAL INCLUDES
 #include <windows.h>
 #include <GL/gl.h>
+#include <assert.h>
 #include <stdlib.h>
 #include <iostream>
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <time.h>
 // INTERNAL INCLUDES
@@ -31,52 +35,140 @@
 #include "backends/imgui_impl_win32.h"
 #include "backends/imgui_impl_opengl2.h"
 #include "resource.h"
+#include "types.h"
+#include "log_store.h"
+#include "log_index.h"
+#include "multi_match.h"
+#include "fuzzy_match.h"
+#include "log_query.h"
+#include "text_scan.h"
+#include "thread_pool.h"
+#include "log_parser.h"
+#include "log_ingest.h"
+#include "log_shm.h"
+#include "process_capture.h"
+#include "log_file.h"
+#include "log_export.h"
+#include "mapped_file.h"
+#include "time_format.h"
+#include "debug_alloc.h"
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #include "version.h"
 
-typedef unsigned char byte;
-
-typedef unsigned char u8;
-typedef unsigned short u16;
-typedef unsigned int u32;
-typedef unsigned long long u64;
-
-typedef signed char i8;
-typedef signed short i16;
-typedef signed int i32;
-typedef signed long long i64;
-
 #pragma comment( lib, "opengl32.lib" )
 
+// COPYDATASTRUCT::dwData identifiers accepted by bSpy
+#define COPYDATA_LOG_RECORD 0xBA88AC0DA // one "timestamp,severity,origin,content" record
+#define COPYDATA_LOG_BATCH  0xBA88AC0DB // many records separated by '\n', up to 8 MB per message
+
+// Posted by the ingest threads when parsed entries are waiting and by the export thread
+// once it ended
+#define WM_LOGS_READY (WM_APP + 1)
+// Frames drawn after the last event, ImGui needs a few to settle hover state and layout
+#define SETTLE_FRAMES 3
+// Longest waits for the next event: while background work is polled every frame, while a
+// text field blinks its cursor, and when idle, where only the store compaction is due
+#define BUSY_WAIT_MS 16
+#define BLINK_WAIT_MS 100
+#define IDLE_WAIT_MS 1000
+
+//********************************************************************************************
+#define FILTER_MATCH_INCLUDE 0x1
+#define FILTER_MATCH_EXCLUDE 0x2
 //********************************************************************************************
-typedef enum log_severity_e
+// What the filter string and the facets compile to. A refilter hands a copy to the
+// thread pool, the view keeps extending its own as new origins show up.
+typedef struct log_filter_rules_t
 {
-    INFO,
-    WARN,
-    FAIL,
-    SUCC,
-    CRIT,
-    DBUG,
-    TRCE
-} log_severity_e;
-//********************************************************************************************
-typedef struct log_entry_t
+    std::vector<std::string> include_filters;
+    std::vector<std::string> exclude_filters;
+    multi_match_t matcher;          // all tokens, flagged FILTER_MATCH_INCLUDE or _EXCLUDE
+    bool ignore_case;
+    u32 max_edits;                  // fuzzy matching when not 0, the tokens below replace matcher
+    std::vector<fuzzy_pattern_t> fuzzy_includes;
+    std::vector<fuzzy_pattern_t> fuzzy_excludes;
+    std::vector<u8> origin_matches; // FILTER_MATCH_* flags per interned origin
+    u8 severity_matches[8];         // FILTER_MATCH_* flags per severity
+    u8 severity_facets;
+    std::vector<u8> origin_hidden;
+    log_query_t query;              // replaces the tokens when the filter uses query syntax
+} log_filter_rules_t;
+//********************************************************************************************
+// Rows of one full segment filtered on the thread pool during a refilter
+typedef struct log_filter_chunk_t
 {
-    u64 timestamp;
-    log_severity_e severity;
-    std::string origin;
-    std::string content;
-} log_entry_t;
+    std::shared_ptr<const log_segment_t> segment;  // held so the store leaves it unchanged
+    u32 begin;                                      // first row still in the store
+    log_group_set_t include_groups;
+    log_group_set_t exclude_groups;
+    std::vector<u32> rows;                          // rows that pass
+    std::atomic<bool> done;
+} log_filter_chunk_t;
+//********************************************************************************************
+typedef struct log_filter_pass_t
+{
+    log_filter_rules_t rules;
+    std::vector<std::shared_ptr<log_filter_chunk_t>> chunks;   // in id order
+    std::atomic<bool> cancel;
+} log_filter_pass_t;
+//********************************************************************************************
+typedef struct log_filter_view_t
+{
+    std::string filter;
+    log_filter_rules_t rules;
+    u8 severity_facets = 0xFF;      // bit per severity shown by the facets
+    std::vector<u8> origin_hidden;  // origins hidden by the facets, by interned id
+    bool ignore_case;
+    u32 max_edits;                  // edits a fuzzy match may take, 0 matches exactly
+    bool options_changed;           // facets or match mode changed
+    std::shared_ptr<log_filter_pass_t> pass;   // refilter still running on the thread pool
+    size_t pass_merged;             // chunks of pass already appended to ids
+    std::deque<u64> ids;            // ids of the log entries that pass the filter
+    u64 scanned;                    // id of the first entry not yet tested
+    u64 generation;                 // store generation the view was built against
+} log_filter_view_t;
+//********************************************************************************************
+// How the log table shows a severity
+typedef struct severity_style_t
+{
+    ImVec4 color;
+    const char* label;
+    u32 label_length;
+} severity_style_t;
+//********************************************************************************************
+// Indexed by log_severity_e, the last entry stands in for values out of range
+static constexpr severity_style_t severity_styles[TRCE + 2] =
+{
+    { ImVec4(0.4f, 0.6f, 0.7f, 1.0f), "INFO", 4 },
+    { ImVec4(0.8f, 0.8f, 0.0f, 1.0f), "WARN", 4 },
+    { ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "FAIL", 4 },
+    { ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "SUCC", 4 },
+    { ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "CRIT", 4 },
+    { ImVec4(0.1f, 0.7f, 0.1f, 1.0f), "DBUG", 4 },
+    { ImVec4(0.8f, 0.2f, 0.8f, 1.0f), "TRCE", 4 },
+    { ImVec4(1.0f, 0.0f, 1.0f, 1.0f), "UNKN", 4 },
+};
+//********************************************************************************************
+static const severity_style_t& severity_style(log_severity_e severity)
+{
+    return severity_styles[(u32)severity <= TRCE ? severity : TRCE + 1];
+}
 //********************************************************************************************
 static HGLRC g_GLRC = NULL;
 static HDC g_HDC = NULL;
 static HWND g_HWND = NULL;
 static bool g_Running = true;
-static std::vector<log_entry_t> log_messages;
+static log_store_t log_messages;
+static log_ingest_t log_ingest;
+static log_shm_t log_shm;
+static log_filter_view_t log_view;
+static log_export_t log_export;
+static time_format_cache_t time_cache;
+static bool show_delta = false;
 static bool auto_scroll = false;
 static bool scroll_refresh = false;
-static HANDLE evenlight_handle;
+static process_capture_t evenlight;
 static char filter_buf[128];
 static GLuint textureID;
 static i32 textureWidth = 0;
@@ -90,21 +182,6 @@ extern IMGUI_IMPL_API LRESULT ImGui_ImplWin32_WndProcHandler(
     LPARAM lParam
 );
 //********************************************************************************************
-const char* severity_to_string(log_severity_e severity)
-{
-    switch (severity)
-    {
-    case INFO: return "INFO";
-    case WARN: return "WARN";
-    case FAIL: return "FAIL";
-    case SUCC: return "SUCC";
-    case CRIT: return "CRIT";
-    case DBUG: return "DBUG";
-    case TRCE: return "TRCE";
-    default: return "UNKN";
-    }
-}
-//********************************************************************************************
 void split_and_add(
     const std::string& input,
     std::vector<std::string>& include_filters,
@@ -130,68 +207,377 @@ void split_and_add(
     }
 }
 //********************************************************************************************
-void apply_filters(
-    const std::string& filter_buf,
-    const std::vector<log_entry_t>& logs,
-    std::vector<log_entry_t*>& filtered_logs)
+// FILTER_MATCH_* flags of the tokens found in text, limited to wanted
+u8 find_tokens(const log_filter_rules_t& rules, const char* text, size_t length, u8 wanted)
 {
-    std::vector<std::string> include_filters;
-    std::vector<std::string> exclude_filters;
+    if (!rules.max_edits)
+        return multi_match_find(rules.matcher, text, length, wanted);
 
-    include_filters.reserve(8);
-    exclude_filters.reserve(8);
+    u8 found = 0;
+    for (size_t i = 0; i < rules.fuzzy_includes.size() && (wanted & FILTER_MATCH_INCLUDE); ++i)
+    {
+        if (fuzzy_find(rules.fuzzy_includes[i], text, length))
+        {
+            found |= FILTER_MATCH_INCLUDE;
+            break;
+        }
+    }
+    for (size_t i = 0; i < rules.fuzzy_excludes.size() && (wanted & FILTER_MATCH_EXCLUDE); ++i)
+    {
+        if (fuzzy_find(rules.fuzzy_excludes[i], text, length))
+        {
+            found |= FILTER_MATCH_EXCLUDE;
+            break;
+        }
+    }
+    return found;
+}
+//********************************************************************************************
+u8 filter_match_flags(const char* text, size_t length, const log_filter_rules_t& rules)
+{
+    return find_tokens(rules, text, length, FILTER_MATCH_INCLUDE | FILTER_MATCH_EXCLUDE);
+}
+//********************************************************************************************
+// content_flags tells which FILTER_MATCH_* tokens the content may contain at all
+bool log_matches_filters(
+    const log_segment_t& segment,
+    const char* text,
+    u32 index,
+    const log_filter_rules_t& rules,
+    u8 content_flags)
+{
+    // Severity and origin results are computed once per distinct value,
+    // only the content has to be searched per entry
+    u8 flags = rules.severity_matches[segment.severities[index] & 7] |
+        rules.origin_matches[segment.origins[index]];
 
-    split_and_add(filter_buf, include_filters, exclude_filters);
+    if (flags & FILTER_MATCH_EXCLUDE)
+        return false;
 
-    filtered_logs.clear();
-    filtered_logs.reserve(logs.size());
+    const bool need_include = !rules.include_filters.empty() && !(flags & FILTER_MATCH_INCLUDE);
+    if (need_include && !(content_flags & FILTER_MATCH_INCLUDE))
+        return false;
 
-    const bool has_includes = !include_filters.empty();
-    const bool has_excludes = !exclude_filters.empty();
+    // Includes and excludes are searched for in the same pass over the content
+    const u8 wanted = content_flags & (need_include ? FILTER_MATCH_INCLUDE | FILTER_MATCH_EXCLUDE : FILTER_MATCH_EXCLUDE);
+    if (!wanted)
+        return true;
+
+    const char* content = text + segment.content_offsets[index];
+    const u8 found = find_tokens(rules, content, segment.content_lengths[index], wanted);
+    if (need_include && !(found & FILTER_MATCH_INCLUDE))
+        return false;
+    return !(found & FILTER_MATCH_EXCLUDE);
+}
+//********************************************************************************************
+// Row groups of the segment whose content may contain any of the tokens, every group
+// when the segment is not indexed yet
+void content_candidates(
+    const log_segment_t& segment,
+    const std::vector<std::string>& tokens,
+    u32 max_edits,
+    log_group_set_t& groups)
+{
+    memset(groups.bits, 0, sizeof(groups.bits));
 
-    for (const auto& log : logs)
+    for (size_t t = 0; t < tokens.size(); ++t)
     {
-        const std::string& content = log.content;
-        const std::string& origin = log.origin;
-        const char* severity_str = severity_to_string(log.severity);
+        const std::string& token = tokens[t];
+        log_group_set_t token_groups;
+        const bool indexed = max_edits ?
+            log_index_fuzzy_candidates(segment, token.data(), token.length(), max_edits, token_groups) :
+            log_index_candidates(segment, token.data(), token.length(), token_groups);
+        if (!indexed)
+        {
+            memset(groups.bits, 0xFF, sizeof(groups.bits));
+            return;
+        }
+        for (u32 w = 0; w < LOG_INDEX_GROUP_WORDS; ++w)
+            groups.bits[w] |= token_groups.bits[w];
+    }
+}
+//********************************************************************************************
+// Rows of the segment left by the severity and origin facets and by severities and
+// origins the filter excludes, computed on the row bitmaps of the segment
+void facet_rows(const log_segment_t& segment, const log_filter_rules_t& rules, u64* rows)
+{
+    u8 severities = rules.severity_facets;
+    for (u32 i = 0; i < 8; ++i)
+    {
+        if (rules.severity_matches[i] & FILTER_MATCH_EXCLUDE)
+            severities &= ~(1 << i);
+    }
 
-        bool include = !has_includes;
+    const log_bitmap_set_t& severity_rows = segment.severity_rows;
+    bool all_severities = true;
+    for (size_t b = 0; b < severity_rows.values.size(); ++b)
+        all_severities &= (severities >> severity_rows.values[b]) & 1;
 
-        if (has_includes)
+    if (all_severities)
+    {
+        const u32 full_words = segment.count / 64;
+        memset(rows, 0xFF, full_words * sizeof(u64));
+        memset(rows + full_words, 0, (LOG_BITMAP_WORDS - full_words) * sizeof(u64));
+        if (segment.count & 63)
+            rows[full_words] = ((u64)1 << (segment.count & 63)) - 1;
+    }
+    else
+    {
+        memset(rows, 0, LOG_BITMAP_WORDS * sizeof(u64));
+        for (size_t b = 0; b < severity_rows.values.size(); ++b)
         {
-            for (size_t i = 0; i < include_filters.size(); ++i)
-            {
-                const std::string& inc = include_filters[i];
-                if (content.find(inc) != std::string::npos ||
-                    origin.find(inc) != std::string::npos ||
-                    std::strstr(severity_str, inc.c_str()))
-                {
-                    include = true;
-                    break;
-                }
-            }
+            if ((severities >> severity_rows.values[b]) & 1)
+                log_bitmap_or(severity_rows.bitmaps[b], rows);
         }
+    }
+
+    const log_bitmap_set_t& origin_rows = segment.origin_rows;
+    for (size_t b = 0; b < origin_rows.values.size(); ++b)
+    {
+        const u16 origin = origin_rows.values[b];
+        const bool hidden = origin < rules.origin_hidden.size() && rules.origin_hidden[origin];
+        if (hidden || (rules.origin_matches[origin] & FILTER_MATCH_EXCLUDE))
+            log_bitmap_andnot(origin_rows.bitmaps[b], rows);
+    }
+}
+//********************************************************************************************
+// Appends the rows of the segment from begin on that pass the filter. Only reads the
+// segment, so workers can run it on segments held by a refilter.
+void filter_segment(
+    const log_segment_t& segment,
+    const char* text,
+    u32 begin,
+    const log_filter_rules_t& rules,
+    const log_group_set_t& include_groups,
+    const log_group_set_t& exclude_groups,
+    std::vector<u32>& passed)
+{
+    if (begin >= segment.count)
+        return;
+
+    const bool pass_all = rules.include_filters.empty() && rules.exclude_filters.empty() && !rules.query.active;
+
+    // When no severity or origin satisfies an include, only rows whose content
+    // contains one can pass and the groups without candidates are skipped whole
+    bool content_only = !rules.include_filters.empty();
+    for (u32 i = 0; i < 8 && content_only; ++i)
+        content_only = !(rules.severity_matches[i] & FILTER_MATCH_INCLUDE);
+    for (size_t i = 0; i < rules.origin_matches.size() && content_only; ++i)
+        content_only = !(rules.origin_matches[i] & FILTER_MATCH_INCLUDE);
+
+    // One word of the row mask covers exactly one index group
+    static_assert(LOG_INDEX_GROUP_ROWS == 64, "row mask words and index groups differ");
+    u64 rows[LOG_BITMAP_WORDS];
+    facet_rows(segment, rules, rows);
+    if (rules.query.active)
+        log_query_rows(rules.query, segment, rows);
+    rows[begin / 64] &= ~(u64)0 << (begin & 63);
+
+    for (u32 w = begin / 64; w * 64 < segment.count; ++w)
+    {
+        u64 word = rows[w];
+        if (!word)
+            continue;
 
-        if (include && has_excludes)
+        u8 content_flags = 0;
+        if (!pass_all)
         {
-            for (size_t i = 0; i < exclude_filters.size(); ++i)
-            {
-                const std::string& exc = exclude_filters[i];
-                if (content.find(exc) != std::string::npos ||
-                    origin.find(exc) != std::string::npos ||
-                    std::strstr(severity_str, exc.c_str()))
-                {
-                    include = false;
-                    break;
-                }
-            }
+            const bool include = log_group_test(include_groups, w);
+            if (content_only && !include)
+                continue;
+            content_flags = (include ? FILTER_MATCH_INCLUDE : 0) |
+                (log_group_test(exclude_groups, w) ? FILTER_MATCH_EXCLUDE : 0);
+        }
+
+        for (; word; word &= word - 1)
+        {
+            const u32 i = w * 64 + log_bitmap_ctz(word);
+            const bool match = rules.query.active ?
+                log_query_match(rules.query, segment, text, i) :
+                pass_all || log_matches_filters(segment, text, i, rules, content_flags);
+            if (match)
+                passed.push_back(i);
+        }
+    }
+}
+//********************************************************************************************
+void filter_chunk(std::shared_ptr<log_filter_pass_t> pass, std::shared_ptr<log_filter_chunk_t> chunk)
+{
+    // A newer filter may have replaced the pass while the chunk was queued
+    if (!pass->cancel.load(std::memory_order_relaxed))
+    {
+        std::vector<char> scratch;
+        const log_segment_t& segment = *chunk->segment;
+        const char* text = log_segment_read_text(segment, scratch);
+        filter_segment(segment, text, chunk->begin, pass->rules,
+            chunk->include_groups, chunk->exclude_groups, chunk->rows);
+    }
+    chunk->done.store(true, std::memory_order_release);
+}
+//********************************************************************************************
+// Returns the number of rows dropped from the top of the view because their
+// entries were evicted by the retention policy
+size_t apply_filters(
+    const char* filter_buf,
+    const log_store_t& logs,
+    log_filter_view_t& view)
+{
+    size_t evicted = 0;
+    log_filter_rules_t& rules = view.rules;
+
+    // Rebuild only when the filter text changed or the logs were cleared/reloaded,
+    // otherwise just test the entries that arrived since the last frame
+    const bool rebuild = view.generation != logs.generation || view.filter != filter_buf || view.options_changed;
+    if (rebuild)
+    {
+        view.options_changed = false;
+        view.filter = filter_buf;
+        // A clear hands out the origin ids again, hiding by id would hit other origins
+        if (view.generation != logs.generation)
+            view.origin_hidden.clear();
+        view.generation = logs.generation;
+        view.scanned = logs.first_id;
+        view.ids.clear();
+        rules.include_filters.clear();
+        rules.exclude_filters.clear();
+        rules.origin_matches.clear();
+        rules.severity_facets = view.severity_facets;
+        rules.origin_hidden = view.origin_hidden;
+        // The query language takes over once the filter uses any of its syntax,
+        // plain comma separated substrings keep their meaning
+        rules.ignore_case = view.ignore_case;
+        rules.max_edits = view.max_edits;
+        log_query_compile(rules.query, filter_buf, view.ignore_case, view.max_edits);
+        if (!rules.query.active)
+            split_and_add(view.filter, rules.include_filters, rules.exclude_filters);
+
+        rules.fuzzy_includes.resize(rules.max_edits ? rules.include_filters.size() : 0);
+        for (size_t i = 0; i < rules.fuzzy_includes.size(); ++i)
+        {
+            const std::string& inc = rules.include_filters[i];
+            fuzzy_pattern_init(rules.fuzzy_includes[i], inc.data(), inc.length(), rules.max_edits, rules.ignore_case);
+        }
+        rules.fuzzy_excludes.resize(rules.max_edits ? rules.exclude_filters.size() : 0);
+        for (size_t i = 0; i < rules.fuzzy_excludes.size(); ++i)
+        {
+            const std::string& exc = rules.exclude_filters[i];
+            fuzzy_pattern_init(rules.fuzzy_excludes[i], exc.data(), exc.length(), rules.max_edits, rules.ignore_case);
+        }
+
+        multi_match_clear(rules.matcher);
+        for (size_t i = 0; i < rules.include_filters.size(); ++i)
+        {
+            const std::string& inc = rules.include_filters[i];
+            multi_match_add(rules.matcher, inc.data(), inc.length(), FILTER_MATCH_INCLUDE);
+        }
+        for (size_t i = 0; i < rules.exclude_filters.size(); ++i)
+        {
+            const std::string& exc = rules.exclude_filters[i];
+            multi_match_add(rules.matcher, exc.data(), exc.length(), FILTER_MATCH_EXCLUDE);
+        }
+        multi_match_build(rules.matcher, rules.ignore_case);
+
+        for (u32 i = 0; i < 8; ++i)
+        {
+            const char* severity_str = severity_to_string((log_severity_e)i);
+            rules.severity_matches[i] = filter_match_flags(severity_str, strlen(severity_str), rules);
+        }
+
+        if (view.pass)
+        {
+            view.pass->cancel.store(true, std::memory_order_relaxed);
+            view.pass.reset();
         }
+    }
+
+    for (size_t i = rules.origin_matches.size(); i < logs.origin_names.size(); ++i)
+    {
+        const std::string& origin = logs.origin_names[i];
+        rules.origin_matches.push_back(filter_match_flags(origin.data(), origin.length(), rules));
+    }
+    log_query_update_origins(rules.query, logs.origin_names);
+    if (rebuild)
+        log_query_plan(rules.query, logs);
 
-        if (include)
+    // Full segments are filtered on the thread pool, one chunk each. The segment still
+    // being appended to is left to the incremental scan below.
+    if (rebuild && logs.segments.size() > 1)
+    {
+        std::shared_ptr<log_filter_pass_t> pass = std::make_shared<log_filter_pass_t>();
+        pass->rules = rules;
+        pass->cancel.store(false, std::memory_order_relaxed);
+
+        thread_pool_t& pool = thread_pool_shared();
+        for (size_t s = 0; s + 1 < logs.segments.size(); ++s)
         {
-            filtered_logs.push_back(const_cast<log_entry_t*>(&log));
+            const log_segment_t& segment = *logs.segments[s];
+            std::shared_ptr<log_filter_chunk_t> chunk = std::make_shared<log_filter_chunk_t>();
+            chunk->segment = logs.segments[s];
+            chunk->begin = segment.first_id < logs.first_id ? (u32)(logs.first_id - segment.first_id) : 0;
+            content_candidates(segment, rules.include_filters, rules.max_edits, chunk->include_groups);
+            content_candidates(segment, rules.exclude_filters, rules.max_edits, chunk->exclude_groups);
+            chunk->done.store(false, std::memory_order_relaxed);
+            pass->chunks.push_back(chunk);
+            thread_pool_submit(pool, [pass, chunk]() { filter_chunk(pass, chunk); });
         }
+
+        view.pass = pass;
+        view.pass_merged = 0;
+        view.scanned = logs.segments.back()->first_id;
     }
+
+    // Show the finished chunks of a refilter in order, as soon as they are available
+    if (view.pass)
+    {
+        std::vector<std::shared_ptr<log_filter_chunk_t>>& chunks = view.pass->chunks;
+        while (view.pass_merged < chunks.size() && chunks[view.pass_merged]->done.load(std::memory_order_acquire))
+        {
+            const log_filter_chunk_t& chunk = *chunks[view.pass_merged];
+            for (size_t i = 0; i < chunk.rows.size(); ++i)
+                view.ids.push_back(chunk.segment->first_id + chunk.rows[i]);
+            chunks[view.pass_merged++].reset();
+        }
+        if (view.pass_merged == chunks.size())
+            view.pass.reset();
+    }
+
+    while (!view.ids.empty() && view.ids.front() < logs.first_id)
+    {
+        view.ids.pop_front();
+        evicted++;
+    }
+
+    // Newer entries wait for the refilter to finish, the view stays in id order
+    if (view.pass)
+        return evicted;
+
+    if (view.scanned < logs.first_id)
+        view.scanned = logs.first_id;
+    if (view.scanned >= logs.next_id)
+        return evicted;
+
+    std::vector<u32> passed;
+    std::vector<char> scratch;
+    for (size_t s = log_store_segment_index(logs, view.scanned); s < logs.segments.size(); ++s)
+    {
+        const log_segment_t& segment = *logs.segments[s];
+
+        log_group_set_t include_groups;
+        log_group_set_t exclude_groups;
+        content_candidates(segment, rules.include_filters, rules.max_edits, include_groups);
+        content_candidates(segment, rules.exclude_filters, rules.max_edits, exclude_groups);
+
+        passed.clear();
+        const char* text = log_segment_read_text(segment, scratch);
+        filter_segment(segment, text, (u32)(view.scanned - segment.first_id),
+            rules, include_groups, exclude_groups, passed);
+        for (size_t i = 0; i < passed.size(); ++i)
+            view.ids.push_back(segment.first_id + passed[i]);
+
+        view.scanned = segment.first_id + segment.count;
+    }
+
+    return evicted;
 }
 //********************************************************************************************
 void open_in_browser(const std::string& url)
@@ -209,18 +595,6 @@ void open_in_browser(const std::string& url)
 #endif
 }
 //********************************************************************************************
-log_severity_e parse_severity(const char* str)
-{
-    if (_stricmp(str, "INFO") == 0) return INFO;
-    if (_stricmp(str, "WARN") == 0) return WARN;
-    if (_stricmp(str, "FAIL") == 0) return FAIL;
-    if (_stricmp(str, "SUCC") == 0) return SUCC;
-    if (_stricmp(str, "CRIT") == 0) return CRIT;
-    if (_stricmp(str, "DBUG") == 0) return DBUG;
-    if (_stricmp(str, "TRCE") == 0) return TRCE;
-    return INFO; // default
-}
-//********************************************************************************************
 std::vector<std::string> find_files(const char* extension)
 {
     std::vector<std::string> result;
@@ -248,177 +622,56 @@ std::vector<std::string> find_files(const char* extension)
     return result;
 }
 //********************************************************************************************
-bool save_logs_to_csv(const char* filename, std::vector<log_entry_t>& logs)
+// Draws in the current text colour, a clicked link is returned through clicked and clicked_end
+void render_line_with_links(const char* line, size_t len, const log_link_t* links, u32 link_count,
+    const char*& clicked, const char*& clicked_end)
 {
-    FILE* f = fopen(filename, "w");
-    if (!f) return false;
-
-    // Write CSV header
-    fprintf(f, "Timestamp,Severity,Origin,Content\n");
+    static const ImVec4 link_color = { 0.35f, 0.65f, 1.0f, 1.0f };
 
-    for (int i = 0; i < logs.size(); ++i) {
-        const log_entry_t* log = &logs[i];
-        fprintf(f, "%llu,%s,%s,%s\n",
-            log->timestamp,
-            severity_to_string(log->severity),
-            log->origin.c_str(),
-            log->content.c_str());
-    }
-
-    fclose(f);
-    return true;
-}
-//********************************************************************************************
-bool load_logs_from_csv(const char* filename, std::vector<log_entry_t>& logs)
-{
-    FILE* f = fopen(filename, "r");
-    if (!f) return false;
-
-    logs.clear(); // clear existing logs
-
-    char line[1024];
-    bool is_header = true;
-
-    while (fgets(line, sizeof(line), f))
+    // Text and links are drawn straight from the store, the links were found on append
+    const char* p = line;
+    const char* end = line + len;
+    for (u32 i = 0; i < link_count; ++i)
     {
-        if (is_header)
-        {
-            // Check for: [Timestamp,Severity,Origin,Content]
-            char* tok = strtok(line, ",");
-            if (strcmp(tok, "Timestamp") != 0)
-            {
-                fclose(f);
-                return false;
-            }
-            tok = strtok(NULL, ",");
-            if (strcmp(tok, "Severity") != 0)
-            {
-                fclose(f);
-                return false;
-            }
-            tok = strtok(NULL, ",");
-            if (strcmp(tok, "Origin") != 0)
-            {
-                fclose(f);
-                return false;
-            }
-            tok = strtok(NULL, "\n");
-            if (strcmp(tok, "Content") != 0)
-            {
-                fclose(f);
-                return false;
-            }
-            is_header = false;
-            continue;
-        }
-
-        // Tokenize CSV line
-        char* tok = strtok(line, ",");
-        if (!tok) continue;
-
-        log_entry_t entry = {};
-
-        // Parse timestamp
-        entry.timestamp = _strtoui64(tok, NULL, 10);
-
-        // Parse severity
-        tok = strtok(NULL, ",");
-        if (!tok) continue;
-        entry.severity = parse_severity(tok);
-
-        // Parse origin
-        tok = strtok(NULL, ",");
-        if (!tok) continue;
-        entry.origin = tok;
-
-        // Parse content (may contain quotes or commas)
-        tok = strtok(NULL, "\n");
-        if (!tok) continue;
-
-        // Remove wrapping quotes if any
-        char* content = tok;
-        size_t len = strlen(content);
-        if (len >= 2 && content[0] == '"' && content[len - 1] == '"') {
-            content[len - 1] = '\0';
-            content++;
-        }
-
-        entry.content = content;
-
-        logs.push_back(entry);
-    }
-
-    if (auto_scroll) scroll_refresh = true;
-
-    fclose(f);
-    return true;
-}
-//********************************************************************************************
-void render_line_with_links (const std::string& line, ImVec4 text_color)
-{
-    ImGui::PushStyleColor(ImGuiCol_Text, text_color);
-
-    const std::string http = "http://";
-    const std::string https = "https://";
-    size_t pos = 0;
-    const size_t len = line.length();
-
-    while (pos < len)
-    {
-        // Find next occurrence of http:// or https://
-        size_t http_pos = line.find(http, pos);
-        size_t https_pos = line.find(https, pos);
-
-        // Choose the earliest one found
-        size_t link_start = std::string::npos;
-        if (http_pos != std::string::npos && https_pos != std::string::npos)
-			link_start = http_pos < https_pos ? http_pos : https_pos;
-        else if (http_pos != std::string::npos)
-            link_start = http_pos;
-        else if (https_pos != std::string::npos)
-            link_start = https_pos;
-
-        // If no more links found, print the rest as normal text
-        if (link_start == std::string::npos)
-        {
-            std::string normal_text = line.substr(pos);
-            ImGui::TextColored(text_color, "%s", normal_text.c_str());
-            break;
-        }
+        const char* link = line + links[i].begin;
+        const char* link_end = link + links[i].length;
 
         // Print normal text before the link
-        if (link_start > pos)
+        if (link > p)
         {
-            std::string normal_text = line.substr(pos, link_start - pos);
-            ImGui::TextColored(text_color, "%s", normal_text.c_str());
+            ImGui::TextUnformatted(p, link);
             ImGui::SameLine(0.0f, 0.0f);
         }
 
-        // Find the end of the link (first space or end of string)
-        size_t link_end = line.find_first_of(" \t\n", link_start);
-        if (link_end == std::string::npos)
-            link_end = len;
-
-        std::string link = line.substr(link_start, link_end - link_start);
-
-        // Render the link as a button
-		std::string link_label = link;
-        link_label.append("##link_button");
-        if (ImGui::Button(link_label.c_str()))
+        ImGui::PushStyleColor(ImGuiCol_Text, link_color);
+        ImGui::TextUnformatted(link, link_end);
+        ImGui::PopStyleColor();
+        if (ImGui::IsItemHovered())
         {
-            open_in_browser(link);
+            ImVec2 min = ImGui::GetItemRectMin();
+            ImVec2 max = ImGui::GetItemRectMax();
+            ImGui::GetWindowDrawList()->AddLine(ImVec2(min.x, max.y - 1.0f), ImVec2(max.x, max.y - 1.0f),
+                ImGui::GetColorU32(link_color));
+            ImGui::SetMouseCursor(ImGuiMouseCursor_Hand);
+            if (ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+            {
+                clicked = link;
+                clicked_end = link_end;
+            }
         }
 
-        pos = link_end;
+        p = link_end;
 
         // Only SameLine if there's still more content
-        if (pos < len)
+        if (p < end)
         {
             ImGui::SameLine(0.0f, 0.0f);
         }
     }
-
-    ImGui::PopStyleColor();
+    if (p < end || link_count == 0)
+    {
+        ImGui::TextUnformatted(p, end);
+    }
 }
 //********************************************************************************************
 void show_about_window(void)
@@ -459,7 +712,7 @@ void show_about_window(void)
     }
 }
 //********************************************************************************************
-void show_log_window(std::vector<log_entry_t>& logs)
+void show_log_window(log_store_t& logs)
 {
     // Fullscreen setup
     ImGuiViewport* viewport = ImGui::GetMainViewport();
@@ -479,6 +732,8 @@ void show_log_window(std::vector<log_entry_t>& logs)
     static bool open_save_modal = false;
     static char save_filename[256] = "evenlight.log";
     static bool save_failed = false;
+    static bool save_in_use = false;
+    static bool save_filtered = false;
     if (ImGui::BeginMenuBar())
     {
         if (ImGui::BeginMenu("File"))
@@ -491,6 +746,7 @@ void show_log_window(std::vector<log_entry_t>& logs)
             {
                 open_save_modal = true;
                 save_failed = false;
+                save_in_use = false;
             }
             if (ImGui::MenuItem("Quit"))
             {
@@ -500,45 +756,27 @@ void show_log_window(std::vector<log_entry_t>& logs)
         }
         if (ImGui::BeginMenu("Macro"))
         {
-            if (ImGui::MenuItem("Start Evenlight"))
+            bool evenlight_running = process_capture_running(evenlight);
+            if (ImGui::MenuItem("Start Evenlight", NULL, false, !evenlight_running))
             {
-                log_messages.clear();
-
-                // start process
-                PROCESS_INFORMATION pi;
-                memset(&pi, 0, sizeof(pi));
-                STARTUPINFOA si;
-                memset(&si, 0, sizeof(si));
-                si.cb = sizeof(si);  // MUST set this!
-				// build first argument string
+                log_store_clear(log_messages);
 
+				// build first argument string
 				char path[MAX_PATH];
                 memset(&path, 0, sizeof(path));
                 GetCurrentDirectoryA(MAX_PATH, path);
 				strcat_s(path, "\\evenlight.exe");
 
-                const char* args = "--logging --dump";
-                if (strlen(path) > 0)
-                {
-                    // prepend path to args
-                    char full_args[MAX_PATH + 10] = { 0 };
-                    sprintf_s(full_args, "%s %s", path, args);
-                    args = full_args;
-				}
-                if (CreateProcessA(
-                    "evenlight.exe",
-                    (char*)args,
-                    NULL, NULL, NULL, NULL, NULL, NULL,
-                    &si,
-                    &pi))
-                {
-                    evenlight_handle = pi.hProcess;
-                }
+                char full_args[MAX_PATH + 32] = { 0 };
+                sprintf_s(full_args, "%s %s", path, "--logging --dump");
+
+                // start process, its stdout and stderr end up in the log
+                process_capture_stop(evenlight);
+                process_capture_start(evenlight, "evenlight.exe", full_args, log_ingest);
             }
-            if (ImGui::MenuItem("Kill Evenlight"))
+            if (ImGui::MenuItem("Kill Evenlight", NULL, false, evenlight_running))
             {
-                // Kill program logic
-                TerminateProcess(evenlight_handle, 0);
+                process_capture_kill(evenlight);
             }
             ImGui::EndMenu();
         }
@@ -548,14 +786,143 @@ void show_log_window(std::vector<log_entry_t>& logs)
 		}
         if (ImGui::Button("Clear"))
         {
-            log_messages.clear();
+            log_store_clear(log_messages);
         }
         ImGui::Text("Filter");
         ImGui::PushItemWidth(200);
-        ImGui::InputTextWithHint("##Filter", "Text or severity", filter_buf, sizeof(filter_buf));
+        ImGui::InputTextWithHint("##Filter", "Text, severity or query", filter_buf, sizeof(filter_buf));
         ImGui::PopItemWidth();
+        if (ImGui::IsItemHovered())
+        {
+            ImGui::SetTooltip(
+                "a,b,!c         content, origin or severity has a or b but not c\n"
+                "origin:name    origin contains name\n"
+                "sev>=WARN      severity at least WARN, also <=, >, <, =\n"
+                "ts:[from,to]   timestamp range, either end may be left out,\n"
+                "               s, ms, us or ns by magnitude, or seconds.fraction\n"
+                "\"a phrase\"     content contains the phrase\n"
+                "/regex/        content matches the regex\n"
+                "AND OR NOT ( ) combine terms, terms next to each other are ANDed");
+        }
+        if (!log_view.rules.query.error.empty())
+        {
+            ImGui::TextDisabled("Matching as text, not a query: %s", log_view.rules.query.error.c_str());
+        }
 
         ImGui::Checkbox("Auto Scroll", &auto_scroll);
+
+        if (ImGui::BeginMenu("Match"))
+        {
+            if (ImGui::Checkbox("Ignore case", &log_view.ignore_case))
+                log_view.options_changed = true;
+            ImGui::Separator();
+            static const char* edit_labels[] = { "Exact", "Fuzzy, 1 edit", "Fuzzy, 2 edits", "Fuzzy, 3 edits" };
+            for (u32 i = 0; i <= FUZZY_MAX_EDITS; ++i)
+            {
+                if (ImGui::RadioButton(edit_labels[i], log_view.max_edits == i))
+                {
+                    log_view.max_edits = i;
+                    log_view.options_changed = true;
+                }
+            }
+            ImGui::EndMenu();
+        }
+        if (ImGui::BeginMenu("Severity"))
+        {
+            for (u32 i = 0; i <= TRCE; ++i)
+            {
+                bool shown = (log_view.severity_facets >> i) & 1;
+                if (ImGui::Checkbox(severity_to_string((log_severity_e)i), &shown))
+                {
+                    log_view.severity_facets ^= (u8)(1 << i);
+                    log_view.options_changed = true;
+                }
+            }
+            ImGui::EndMenu();
+        }
+        if (ImGui::BeginMenu("Origin"))
+        {
+            std::vector<u8>& hidden = log_view.origin_hidden;
+            if (hidden.size() < logs.origin_names.size())
+                hidden.resize(logs.origin_names.size(), 0);
+
+            if (ImGui::MenuItem("Show all", NULL, false, !logs.origin_names.empty()))
+            {
+                hidden.assign(hidden.size(), 0);
+                log_view.options_changed = true;
+            }
+            ImGui::Separator();
+            for (size_t i = 0; i < logs.origin_names.size(); ++i)
+            {
+                ImGui::PushID((int)i);
+                bool shown = !hidden[i];
+                if (ImGui::Checkbox(logs.origin_names[i].c_str(), &shown))
+                {
+                    hidden[i] = !shown;
+                    log_view.options_changed = true;
+                }
+                ImGui::PopID();
+            }
+            ImGui::EndMenu();
+        }
+
+        if (ImGui::BeginMenu("Time"))
+        {
+            static const char* precision_labels[] = { "Seconds", "Milliseconds", "Microseconds" };
+            for (u32 i = TIME_SECONDS; i <= TIME_MICROSECONDS; ++i)
+            {
+                if (ImGui::RadioButton(precision_labels[i], time_cache.precision == (time_precision_e)i))
+                    time_format_set_precision(time_cache, (time_precision_e)i);
+            }
+            ImGui::Separator();
+            ImGui::Checkbox("Delta to previous row", &show_delta);
+            ImGui::EndMenu();
+        }
+
+        if (ImGui::BeginMenu("Retention"))
+        {
+            log_retention_t retention = logs.retention;
+            u64 max_mb = retention.max_bytes / (1024 * 1024);
+
+            bool changed = false;
+            ImGui::PushItemWidth(120);
+            changed |= ImGui::InputScalar("Max entries", ImGuiDataType_U64, &retention.max_entries);
+            changed |= ImGui::InputScalar("Max MB", ImGuiDataType_U64, &max_mb);
+            changed |= ImGui::InputScalar("Max age (s)", ImGuiDataType_U64, &retention.max_age);
+            ImGui::PopItemWidth();
+            ImGui::TextDisabled("0 = unlimited");
+            ImGui::TextDisabled("Held: %.1f MB, freed per %u entries",
+                log_store_held_bytes(logs) / (1024.0 * 1024.0), LOG_SEGMENT_CAPACITY);
+            ImGui::Checkbox("Compress old entries", &logs.compress_cold);
+
+            if (changed)
+            {
+                retention.max_bytes = max_mb * 1024 * 1024;
+                log_store_set_retention(logs, retention);
+            }
+            ImGui::EndMenu();
+        }
+        if (logs.dropped > 0)
+        {
+            ImGui::TextDisabled("Dropped: %llu", logs.dropped);
+        }
+
+        // Entries that never reached the store, the ring was full or a message too large
+        const u64 ring_lost = log_shm_dropped(log_shm);
+        if (ring_lost > 0)
+        {
+            ImGui::TextDisabled("Ring lost: %llu", ring_lost);
+        }
+        const u64 rejected = log_ingest.rejected.load(std::memory_order_relaxed);
+        if (rejected > 0)
+        {
+            ImGui::TextDisabled("Rejected: %llu", rejected);
+        }
+        if (log_view.pass)
+        {
+            size_t chunks = log_view.pass->chunks.size();
+            ImGui::TextDisabled("Filtering %d%%", (int)(100 * log_view.pass_merged / chunks));
+        }
         ImGui::EndMenuBar();
     }
     // Modal implementation
@@ -564,34 +931,72 @@ void show_log_window(std::vector<log_entry_t>& logs)
         ImGui::OpenPopup("Save Log As");
         if (ImGui::BeginPopupModal("Save Log As", NULL, ImGuiWindowFlags_AlwaysAutoResize))
         {
-            ImGui::Text("Enter filename to save log:");
+            ImGui::Text("Enter filename to save log (.bspy binary, .jsonl JSON Lines, else CSV):");
             ImGui::InputText("##Filename", save_filename, IM_ARRAYSIZE(save_filename));
 
+            // The view only holds part of the matches until a refilter pass is merged
+            const bool filtering = log_view.pass != nullptr;
+            ImGui::BeginDisabled(filtering);
+            ImGui::Checkbox("Filtered entries only", &save_filtered);
+            ImGui::EndDisabled();
+            if (filtering)
+            {
+                ImGui::SameLine();
+                ImGui::TextDisabled("(waiting for the filter)");
+            }
+
             if (save_failed)
             {
                 ImGui::TextColored(ImVec4(1, 0, 0, 1), "Failed to save file!");
             }
+            if (save_in_use)
+            {
+                ImGui::TextColored(ImVec4(1, 0, 0, 1), "Loaded entries still read this file, pick another name or Clear first.");
+            }
+
+            // The export runs in the background, collect its result once it is done
+            bool saved;
+            if (log_export_poll(log_export, saved))
+            {
+                save_failed = !saved && !log_export.progress.cancel;
+                if (saved)
+                {
+                    open_save_modal = false;
+                    ImGui::CloseCurrentPopup();
+                }
+            }
 
             ImGui::Separator();
 
-            if (ImGui::Button("Save"))
+            if (log_export_busy(log_export))
             {
-                if (!save_logs_to_csv(save_filename, logs))
+                char overlay[64];
+                snprintf(overlay, sizeof(overlay), "%llu / %llu",
+                    log_export.progress.rows.load(), log_export.total);
+                ImGui::ProgressBar(log_export_fraction(log_export), ImVec2(300, 0), overlay);
+                if (ImGui::Button("Cancel"))
                 {
-                    save_failed = true;
+                    log_export.progress.cancel = true;
                 }
-                else
+            }
+            else
+            {
+                ImGui::BeginDisabled(save_filtered && filtering);
+                if (ImGui::Button("Save"))
+                {
+                    // Loaded files stay mapped, replacing one would pull the rows from under the export
+                    save_in_use = mapped_file_in_use(save_filename);
+                    const std::deque<u64>* ids = save_filtered ? &log_view.ids : NULL;
+                    save_failed = !save_in_use && !log_export_start(log_export, logs, ids, save_filename);
+                }
+                ImGui::EndDisabled();
+                ImGui::SameLine();
+                if (ImGui::Button("Cancel"))
                 {
                     open_save_modal = false;
                     ImGui::CloseCurrentPopup();
                 }
             }
-            ImGui::SameLine();
-            if (ImGui::Button("Cancel"))
-            {
-                open_save_modal = false;
-                ImGui::CloseCurrentPopup();
-            }
 
             ImGui::EndPopup();
         }
@@ -609,10 +1014,12 @@ void show_log_window(std::vector<log_entry_t>& logs)
             ImGui::Text("Select a file:");
             std::vector<std::string> files;
             static u32 selected_index = 0;
-            // Load list of .csv files once when modal is opened
+            // Load list of .log and .bspy files once when modal is opened
             if (files.empty())
             {
                 files = find_files(".log");
+                std::vector<std::string> captures = find_files(".bspy");
+                files.insert(files.end(), captures.begin(), captures.end());
             }
 
             if (!files.empty())
@@ -642,7 +1049,7 @@ void show_log_window(std::vector<log_entry_t>& logs)
             }
             else
             {
-                ImGui::TextColored(ImVec4(1, 0, 0, 1), "No *.log files found.");
+                ImGui::TextColored(ImVec4(1, 0, 0, 1), "No *.log or *.bspy files found.");
             }
 
             ImGui::Separator();
@@ -651,9 +1058,10 @@ void show_log_window(std::vector<log_entry_t>& logs)
             {
                 if (!files.empty())
                 {
-                    log_messages.clear();
+                    // The loader replaces the entries, a file it refuses leaves them as they are
                     const std::string& selected_filename = files[selected_index];
-                    load_logs_from_csv(selected_filename.c_str(), log_messages);
+                    if (load_logs_from_file(selected_filename.c_str(), log_messages) && auto_scroll)
+                        scroll_refresh = true;
                 }
                 open_load_modal = false;
                 ImGui::CloseCurrentPopup();
@@ -677,94 +1085,98 @@ void show_log_window(std::vector<log_entry_t>& logs)
         open_load_modal = false;
     }
 
+    size_t evicted_rows = apply_filters(filter_buf, logs, log_view);
+    const std::deque<u64>& filtered_logs = log_view.ids;
+
+    // Keep the visible rows in place when evicted entries disappear from the top
+    static float log_scroll_y = 0.0f;
+    static float log_row_height = 0.0f;
+    if (evicted_rows > 0 && log_scroll_y > 0.0f)
+    {
+        float scroll_y = log_scroll_y - evicted_rows * log_row_height;
+        ImGui::SetNextWindowScroll(ImVec2(-1.0f, scroll_y > 0.0f ? scroll_y : 0.0f));
+    }
+
     // Table for logs
     ImGui::BeginChild("LogTableRegion", ImVec2(0, 0), true, ImGuiWindowFlags_AlwaysVerticalScrollbar);
-    if (ImGui::BeginTable("LogTable", 4, ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg))
+    if (ImGui::BeginTable("LogTable", show_delta ? 5 : 4, ImGuiTableFlags_Resizable | ImGuiTableFlags_RowBg))
     {
         ImGui::TableSetupColumn("Datetime");
+        if (show_delta)
+            ImGui::TableSetupColumn("Delta");
         ImGui::TableSetupColumn("Severity");
         ImGui::TableSetupColumn("Origin");
         ImGui::TableSetupColumn("Content");
         ImGui::TableHeadersRow();
 
-        std::vector<log_entry_t*> filtered_logs;
-        filtered_logs.clear();
-
-        apply_filters(filter_buf, logs, filtered_logs);
-
         ImGuiListClipper clipper;
         clipper.Begin((int)filtered_logs.size());
+        const char* clicked_link = NULL;
+        const char* clicked_link_end = NULL;
         while (clipper.Step())
         {
+            // Cold segments allocate when their content is unpacked, so that happens first
+            for (int i = clipper.DisplayStart > 0 ? clipper.DisplayStart - 1 : 0; i < clipper.DisplayEnd; ++i)
+            {
+                log_entry_ref_t log;
+                log_store_get(logs, filtered_logs[i], log);
+            }
+#if DEBUG_ALLOC_COUNT
+            const u64 allocations = debug_alloc_count();
+#endif
             for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
             {
                 ImGui::TableNextRow();
 
-                time_t tm = logs[i].timestamp;
-                char buffer[26];
-                struct tm tm_info;
-                localtime_s(&tm_info, &tm);
-                strftime(buffer, 26, "%Y-%m-%d %H:%M:%S", &tm_info);
+                log_entry_ref_t log;
+                if (!log_store_get(logs, filtered_logs[i], log))
+                    continue;
 
-                ImVec4 text_color;
-                switch (filtered_logs[i]->severity)
-                {
-                case INFO:
-                {
-                    text_color = { 0.4f, 0.6f, 0.7f, 1.0f };
-                    break;
-                }
-                case WARN:
-                {
-                    text_color = { 0.8f, 0.8f, 0.0f, 1.0f };
-                    break;
-                }
-                case FAIL:
-                {
-                    text_color = { 1.0f, 0.3f, 0.3f, 1.0f };
-                    break;
-                }
-                case SUCC:
-                {
-                    text_color = { 0.0f, 1.0f, 0.0f, 1.0f };
-                    break;
-                }
-                case CRIT:
-                {
-                    text_color = { 1.0f, 0.0f, 0.0f, 1.0f };
-                    break;
-                }
-                case DBUG:
-                {
-                    text_color = { 0.1f, 0.7f, 0.1f, 1.0f };
-                    break;
-                }
-                case TRCE:
-                {
-                    text_color = { 0.8f, 0.2f, 0.8f, 1.0f };
-                    break;
-                }
-                default:
+                const char* datetime = time_format_row(time_cache, filtered_logs[i], log.timestamp);
+
+                const severity_style_t& style = severity_style(log.severity);
+                ImGui::PushStyleColor(ImGuiCol_Text, style.color);
+
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(datetime);
+
+                if (show_delta)
                 {
-                    text_color = { 1.0f, 0.0f, 1.0f, 1.0f };
-                    break;
-                }
+                    // Time since the row above in the current view
+                    ImGui::TableNextColumn();
+                    log_entry_ref_t previous;
+                    if (i > 0 && log_store_get(logs, filtered_logs[i - 1], previous))
+                    {
+                        const i64 delta = (i64)(log.timestamp - previous.timestamp);
+                        ImGui::TextUnformatted(time_format_row_delta(time_cache, filtered_logs[i], delta));
+                    }
                 }
 
-                ImGui::TableSetColumnIndex(0);
-                ImGui::TextColored(text_color, "%s", buffer);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(style.label, style.label + style.label_length);
 
-                ImGui::TableSetColumnIndex(1);
-                ImGui::TextColored(text_color, "%s", severity_to_string(filtered_logs[i]->severity));
+                ImGui::TableNextColumn();
+                const std::string& origin = log_store_origin(logs, log.origin);
+                ImGui::TextUnformatted(origin.data(), origin.data() + origin.length());
 
-                ImGui::TableSetColumnIndex(2);
-                ImGui::TextColored(text_color, "%s", filtered_logs[i]->origin.c_str());
+                ImGui::TableNextColumn();
+                render_line_with_links(log.content, log.content_length, log.links, log.link_count,
+                    clicked_link, clicked_link_end);
 
-                ImGui::TableSetColumnIndex(3);
-                render_line_with_links(filtered_logs[i]->content, text_color);
+                ImGui::PopStyleColor();
             }
+#if DEBUG_ALLOC_COUNT
+            assert(debug_alloc_count() == allocations && "log table rows must draw without heap allocations");
+#endif
         }
 
+        // Opened once the rows are drawn, copying the link is the only allocation it needs
+        if (clicked_link)
+            open_in_browser(std::string(clicked_link, clicked_link_end));
+
+        if (clipper.ItemsHeight > 0.0f)
+            log_row_height = clipper.ItemsHeight;
+
         if (scroll_refresh && ImGui::GetScrollY() < ImGui::GetScrollMaxY())
         {
             ImGui::SetScrollHereY(1.0f);
@@ -773,6 +1185,7 @@ void show_log_window(std::vector<log_entry_t>& logs)
 
         ImGui::EndTable();
     }
+    log_scroll_y = ImGui::GetScrollY();
     ImGui::EndChild();
     ImGui::End(); // End main window
 
@@ -795,41 +1208,26 @@ LRESULT CALLBACK wnd_proc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
         g_Running = false;
         PostQuitMessage(0);
         return 0;
+    case WM_LOGS_READY:
+        // Only wakes the main loop, the entries are drained there
+        return 0;
     case WM_COPYDATA:
     {
         COPYDATASTRUCT* cds = (COPYDATASTRUCT*)lParam;
-        if (cds->dwData == 0xBA88AC0DA) // Custom data identifier
-        {
-            // each message is a single log entry in the format: "timestamp;severity;origin;content"
-            char* data = (char*)cds->lpData;
-            char* tok = strtok(data, ",");
-            if (!tok) return 0;
-
-            log_entry_t entry = {};
-
-            entry.timestamp = _strtoui64(tok, NULL, 10);
-            tok = strtok(NULL, ",");
-            if (!tok) return 0;
-            entry.severity = parse_severity(tok);
-            tok = strtok(NULL, ",");
-            if (!tok) return 0;
-            entry.origin = tok;
-            tok = strtok(NULL, "\n");
-            if (!tok) return 0;
-            // Remove wrapping quotes if any
-            char* content = tok;
-            size_t len = strlen(content);
-            if (len >= 2 && content[0] == '"' && content[len - 1] == '"')
-            {
-                content[len - 1] = '\0';
-                content++;
-            }
-
-            entry.content = content;
-            log_messages.push_back(entry);
-
-            if (auto_scroll) scroll_refresh = true;
+        if (cds->dwData == COPYDATA_LOG_RECORD)
+        {
+            // each message is a single log entry in the format: "timestamp,severity,origin,content"
+            // only copy it here, parsing happens on the ingest thread so the sender is released quickly
+            log_ingest_push(log_ingest, LOG_INGEST_RECORD, cds->lpData, cds->cbData);
+            return TRUE;
         }
+        if (cds->dwData == COPYDATA_LOG_BATCH)
+        {
+            // same record format, one entry per line
+            log_ingest_push(log_ingest, LOG_INGEST_LINES, cds->lpData, cds->cbData);
+            return TRUE;
+        }
+        return DefWindowProc(hWnd, msg, wParam, lParam);
     }
     default:
         return DefWindowProc(hWnd, msg, wParam, lParam);
@@ -891,6 +1289,11 @@ bool create_gl_window(const char* title, int width, int height)
 //********************************************************************************************
 void cleanup()
 {
+    log_export_cancel(log_export);
+    process_capture_stop(evenlight);
+    log_shm_close(log_shm);
+    log_ingest_stop(log_ingest);
+
     ImGui_ImplOpenGL2_Shutdown();
     ImGui_ImplWin32_Shutdown();
     ImGui::DestroyContext();
@@ -911,6 +1314,22 @@ void cleanup()
     UnregisterClass(L"BrcdLogger", GetModuleHandle(NULL));
 }
 //********************************************************************************************
+static void wake_ui(void*)
+{
+    // Any posted message ends the wait in the main loop
+    PostMessage(g_HWND, WM_LOGS_READY, 0, 0);
+}
+//********************************************************************************************
+// How long the main loop may sleep before it has to draw or compact again
+static DWORD frame_wait(const ImGuiIO& io)
+{
+    if (log_view.pass || log_export_busy(log_export) || !log_messages.index_jobs.empty())
+        return BUSY_WAIT_MS;
+    if (io.WantTextInput)
+        return BLINK_WAIT_MS;
+    return IDLE_WAIT_MS;
+}
+//********************************************************************************************
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
 {
     if (!create_gl_window("bSpy", 1024, 768))
@@ -975,14 +1394,30 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
     ImGui_ImplWin32_Init(g_HWND);
     ImGui_ImplOpenGL2_Init();
 
+    log_ingest.notify = wake_ui;
+    log_export.notify = wake_ui;
+    log_ingest_start(log_ingest);
+
+    // High rate producers write into a shared ring instead of sending window messages
+    if (log_shm_create(log_shm, LOG_SHM_DEFAULT_NAME, LOG_SHM_DEFAULT_CAPACITY))
+        log_shm_start_reader(log_shm, log_ingest);
+
     LARGE_INTEGER freq;
     QueryPerformanceFrequency(&freq);
 
-    float targetFrameSeconds = 1.0 / 120.0;
+    LARGE_INTEGER lastCompact;
+    QueryPerformanceCounter(&lastCompact);
 
+    // Frames are only drawn for input, new entries or something that changes on its own,
+    // otherwise the thread sleeps until a message arrives. Vsync paces the frames drawn.
+    u32 pending_frames = SETTLE_FRAMES;
     MSG msg;
     while (g_Running)
     {
+        const DWORD wait = frame_wait(*io);
+        if (pending_frames == 0)
+            MsgWaitForMultipleObjects(0, NULL, FALSE, wait, QS_ALLINPUT);
+
         LARGE_INTEGER frameStart;
         QueryPerformanceCounter(&frameStart);
 
@@ -990,8 +1425,36 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
         {
             TranslateMessage(&msg);
             DispatchMessage(&msg);
+            pending_frames = SETTLE_FRAMES;
+        }
+
+        // Pick up everything the ingest thread parsed since the last frame
+        if (log_ingest_drain(log_ingest, log_messages) > 0)
+        {
+            pending_frames = SETTLE_FRAMES;
+            if (auto_scroll)
+                scroll_refresh = true;
+        }
+
+        // Index the content of segments that filled up since the last frame. Finished
+        // background jobs are drawn like new entries, the export posts a message instead.
+        if (log_index_update(log_messages) > 0)
+            pending_frames = SETTLE_FRAMES;
+
+        // Pack cold segments and drop unpacked copies nobody looked at for a while
+        if (frameStart.QuadPart - lastCompact.QuadPart >= freq.QuadPart)
+        {
+            if (log_store_compact(log_messages) > 0)
+                pending_frames = SETTLE_FRAMES;
+            lastCompact = frameStart;
         }
 
+        // Progress and blinking cursors are drawn at their own pace, an idle wake up only compacts
+        if (pending_frames == 0 && wait == IDLE_WAIT_MS)
+            continue;
+        if (pending_frames > 0)
+            pending_frames--;
+
         ImGui_ImplOpenGL2_NewFrame();
         ImGui_ImplWin32_NewFrame();
         ImGui::NewFrame();
@@ -1004,16 +1467,6 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
         glClear(GL_COLOR_BUFFER_BIT);
         ImGui_ImplOpenGL2_RenderDrawData(ImGui::GetDrawData());
         SwapBuffers(g_HDC);
-
-        LARGE_INTEGER frameEnd;
-        QueryPerformanceCounter(&frameEnd);
-        float elapsedSeconds = (float)(frameEnd.QuadPart - frameStart.QuadPart) / freq.QuadPart;
-        
-        if (elapsedSeconds < targetFrameSeconds)
-        {
-            DWORD sleepMS = DWORD((targetFrameSeconds - elapsedSeconds) * 1000);
-            Sleep(sleepMS);
-        }
     }
 
     cleanup();
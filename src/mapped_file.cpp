@@ -0,0 +1,188 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <mutex>
+#include <stdio.h>
+#include <vector>
+// INTERNAL INCLUDES
+#include "mapped_file.h"
+
+// Mappings handed out so far, expired ones are dropped on the next open
+static std::mutex mapped_files_mutex;
+static std::vector<std::weak_ptr<mapped_file_t>> mapped_files;
+
+//********************************************************************************************
+static bool file_identity(const char* filename, u64& device, u64& index)
+{
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(filename, 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+        NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    BY_HANDLE_FILE_INFORMATION info;
+    bool found = GetFileInformationByHandle(file, &info) != 0;
+    CloseHandle(file);
+    if (!found)
+        return false;
+    device = info.dwVolumeSerialNumber;
+    index = ((u64)info.nFileIndexHigh << 32) | info.nFileIndexLow;
+#else
+    struct stat st;
+    if (stat(filename, &st) != 0)
+        return false;
+    device = (u64)st.st_dev;
+    index = (u64)st.st_ino;
+#endif
+    return true;
+}
+//********************************************************************************************
+static void mapped_file_close(mapped_file_t* file)
+{
+#if defined(_WIN32)
+    if (file->data)
+        UnmapViewOfFile(file->data);
+    if (file->mapping)
+        CloseHandle(file->mapping);
+    if (file->file && file->file != INVALID_HANDLE_VALUE)
+        CloseHandle(file->file);
+#else
+    if (file->data && file->size > 0)
+        munmap(file->data, file->size);
+    if (file->fd >= 0)
+        close(file->fd);
+#endif
+    delete file;
+}
+//********************************************************************************************
+std::shared_ptr<mapped_file_t> mapped_file_open(const char* filename)
+{
+    mapped_file_t* file = new mapped_file_t();
+    std::shared_ptr<mapped_file_t> result(file, mapped_file_close);
+
+#if defined(_WIN32)
+    // Others may still rename or replace the file, the mapping keeps the old contents
+    file->file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file->file == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    BY_HANDLE_FILE_INFORMATION info;
+    if (!GetFileInformationByHandle(file->file, &info))
+        return NULL;
+    file->device = info.dwVolumeSerialNumber;
+    file->index = ((u64)info.nFileIndexHigh << 32) | info.nFileIndexLow;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file->file, &size))
+        return NULL;
+    file->size = (size_t)size.QuadPart;
+    if (file->size == 0)
+        return result; // nothing to map
+
+    file->mapping = CreateFileMappingA(file->file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (!file->mapping)
+        return NULL;
+
+    file->data = (char*)MapViewOfFile(file->mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (!file->data)
+        return NULL;
+#else
+    file->fd = open(filename, O_RDONLY);
+    if (file->fd < 0)
+        return NULL;
+
+    struct stat st;
+    if (fstat(file->fd, &st) != 0)
+        return NULL;
+    file->device = (u64)st.st_dev;
+    file->index = (u64)st.st_ino;
+    file->size = (size_t)st.st_size;
+    if (file->size == 0)
+        return result; // nothing to map
+
+    void* data = mmap(NULL, file->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file->fd, 0);
+    if (data == MAP_FAILED)
+        return NULL;
+    file->data = (char*)data;
+    madvise(data, file->size, MADV_SEQUENTIAL);
+#endif
+
+    std::lock_guard<std::mutex> lock(mapped_files_mutex);
+    for (size_t i = 0; i < mapped_files.size();)
+    {
+        if (mapped_files[i].expired())
+        {
+            mapped_files[i] = mapped_files.back();
+            mapped_files.pop_back();
+        }
+        else
+        {
+            ++i;
+        }
+    }
+    mapped_files.push_back(result);
+    return result;
+}
+//********************************************************************************************
+bool mapped_file_in_use(const char* filename)
+{
+    u64 device, index;
+    if (!file_identity(filename, device, index))
+        return false;
+
+    std::lock_guard<std::mutex> lock(mapped_files_mutex);
+    for (size_t i = 0; i < mapped_files.size(); ++i)
+    {
+        std::shared_ptr<mapped_file_t> file = mapped_files[i].lock();
+        if (file && file->device == device && file->index == index)
+            return true;
+    }
+    return false;
+}
+//********************************************************************************************
+std::string file_temp_name(const char* filename)
+{
+    return std::string(filename) + ".tmp";
+}
+//********************************************************************************************
+bool file_commit(const char* temp, const char* target, bool saved)
+{
+#if defined(_WIN32)
+    if (saved && MoveFileExA(temp, target, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+        return true;
+#else
+    if (saved && rename(temp, target) == 0)
+        return true;
+#endif
+    remove(temp);
+    return false;
+}
+//********************************************************************************************
@@ -0,0 +1,326 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#include <string.h>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define MULTI_MATCH_X86 1
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+// INTERNAL INCLUDES
+#include "multi_match.h"
+#include "text_scan.h"
+
+// GCC and Clang only emit vector instructions in functions marked for them
+#if defined(__GNUC__)
+#define MULTI_MATCH_TARGET(isa) __attribute__((target(isa)))
+#else
+#define MULTI_MATCH_TARGET(isa)
+#endif
+
+//********************************************************************************************
+void multi_match_clear(multi_match_t& matcher)
+{
+    matcher.patterns.clear();
+    matcher.flags.clear();
+}
+//********************************************************************************************
+void multi_match_add(multi_match_t& matcher, const char* pattern, size_t length, u8 flags)
+{
+    matcher.patterns.emplace_back(pattern, length);
+    matcher.flags.push_back(flags);
+}
+//********************************************************************************************
+static void set_bucket(u8* table, u8* lo, u8* hi, u8 c, u8 bit, bool ignore_case)
+{
+    table[c] |= bit;
+    lo[c & 15] |= bit;
+    hi[c >> 4] |= bit;
+
+    if (ignore_case && c >= 'a' && c <= 'z')
+        set_bucket(table, lo, hi, (u8)(c - ('a' - 'A')), bit, false);
+}
+//********************************************************************************************
+void multi_match_build(multi_match_t& matcher, bool ignore_case)
+{
+    for (u32 b = 0; b < MULTI_MATCH_BUCKETS; ++b)
+        matcher.buckets[b].clear();
+    memset(matcher.first, 0, sizeof(matcher.first));
+    memset(matcher.second, 0, sizeof(matcher.second));
+    memset(matcher.first_lo, 0, sizeof(matcher.first_lo));
+    memset(matcher.first_hi, 0, sizeof(matcher.first_hi));
+    memset(matcher.second_lo, 0, sizeof(matcher.second_lo));
+    memset(matcher.second_hi, 0, sizeof(matcher.second_hi));
+    matcher.short_buckets = 0;
+    matcher.empty_flags = 0;
+    matcher.all_flags = 0;
+    matcher.ignore_case = ignore_case;
+
+    u32 next_bucket = 0;
+    for (size_t p = 0; p < matcher.patterns.size(); ++p)
+    {
+        std::string& pattern = matcher.patterns[p];
+        matcher.all_flags |= matcher.flags[p];
+        if (ignore_case)
+        {
+            for (size_t c = 0; c < pattern.length(); ++c)
+                pattern[c] = scan_fold(pattern[c]);
+        }
+        if (pattern.empty())
+        {
+            matcher.empty_flags |= matcher.flags[p];
+            continue;
+        }
+
+        const u32 bucket = next_bucket++ % MULTI_MATCH_BUCKETS;
+        const u8 bit = (u8)(1 << bucket);
+        matcher.buckets[bucket].push_back((u32)p);
+
+        set_bucket(matcher.first, matcher.first_lo, matcher.first_hi, (u8)pattern[0], bit, ignore_case);
+        if (pattern.length() >= 2)
+            set_bucket(matcher.second, matcher.second_lo, matcher.second_hi, (u8)pattern[1], bit, ignore_case);
+        else
+        {
+            // Any byte, or none at the end of the text, may follow a 1-byte pattern
+            for (u32 c = 0; c < 256; ++c)
+                matcher.second[c] |= bit;
+            for (u32 n = 0; n < 16; ++n)
+            {
+                matcher.second_lo[n] |= bit;
+                matcher.second_hi[n] |= bit;
+            }
+            matcher.short_buckets |= bit;
+        }
+    }
+}
+//********************************************************************************************
+// Tests the patterns of the candidate buckets at pos, true once all wanted flags are found
+static bool verify(
+    const multi_match_t& matcher,
+    const char* text,
+    size_t length,
+    size_t pos,
+    u32 bucket_bits,
+    u8 wanted,
+    u8& found)
+{
+    for (; bucket_bits; bucket_bits &= bucket_bits - 1)
+    {
+        const std::vector<u32>& bucket = matcher.buckets[scan_ctz(bucket_bits)];
+        for (size_t i = 0; i < bucket.size(); ++i)
+        {
+            const u32 p = bucket[i];
+            if (!(matcher.flags[p] & wanted & ~found))
+                continue;
+
+            const std::string& pattern = matcher.patterns[p];
+            if (pattern.length() <= length - pos &&
+                (matcher.ignore_case ?
+                    scan_equal_folded(text + pos, pattern.data(), pattern.length()) :
+                    memcmp(text + pos, pattern.data(), pattern.length()) == 0))
+            {
+                found |= matcher.flags[p] & wanted;
+                if (found == wanted)
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+//********************************************************************************************
+static u8 find_scalar(
+    const multi_match_t& matcher,
+    const char* text,
+    size_t length,
+    size_t pos,
+    u8 wanted,
+    u8 found)
+{
+    const u8* bytes = (const u8*)text;
+    for (; pos < length; ++pos)
+    {
+        const u32 bits = matcher.first[bytes[pos]] &
+            (pos + 1 < length ? matcher.second[bytes[pos + 1]] : matcher.short_buckets);
+        if (bits && verify(matcher, text, length, pos, bits, wanted, found))
+            break;
+    }
+    return found;
+}
+//********************************************************************************************
+#if defined(MULTI_MATCH_X86)
+MULTI_MATCH_TARGET("sse4.2")
+static u8 find_sse42(const multi_match_t& matcher, const char* text, size_t length, u8 wanted, u8 found)
+{
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i first_lo = _mm_load_si128((const __m128i*)matcher.first_lo);
+    const __m128i first_hi = _mm_load_si128((const __m128i*)matcher.first_hi);
+    const __m128i second_lo = _mm_load_si128((const __m128i*)matcher.second_lo);
+    const __m128i second_hi = _mm_load_si128((const __m128i*)matcher.second_hi);
+
+    // Each step reads the byte after its 16 positions as well
+    size_t pos = 0;
+    for (; pos + 17 <= length; pos += 16)
+    {
+        const __m128i a = _mm_loadu_si128((const __m128i*)(text + pos));
+        const __m128i b = _mm_loadu_si128((const __m128i*)(text + pos + 1));
+        const __m128i first = _mm_and_si128(
+            _mm_shuffle_epi8(first_lo, _mm_and_si128(a, nibble)),
+            _mm_shuffle_epi8(first_hi, _mm_and_si128(_mm_srli_epi16(a, 4), nibble)));
+        const __m128i second = _mm_and_si128(
+            _mm_shuffle_epi8(second_lo, _mm_and_si128(b, nibble)),
+            _mm_shuffle_epi8(second_hi, _mm_and_si128(_mm_srli_epi16(b, 4), nibble)));
+        const __m128i buckets = _mm_and_si128(first, second);
+
+        u32 mask = ~(u32)_mm_movemask_epi8(_mm_cmpeq_epi8(buckets, zero)) & 0xFFFF;
+        if (!mask)
+            continue;
+
+        alignas(16) u8 bits[16];
+        _mm_store_si128((__m128i*)bits, buckets);
+        for (; mask; mask &= mask - 1)
+        {
+            const u32 j = scan_ctz(mask);
+            if (verify(matcher, text, length, pos + j, bits[j], wanted, found))
+                return found;
+        }
+    }
+    return find_scalar(matcher, text, length, pos, wanted, found);
+}
+//********************************************************************************************
+MULTI_MATCH_TARGET("avx2")
+static u8 find_avx2(const multi_match_t& matcher, const char* text, size_t length, u8 wanted, u8 found)
+{
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    const __m256i zero = _mm256_setzero_si256();
+    // The byte shuffle looks up each 128-bit lane separately, both get the same table
+    const __m256i first_lo = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)matcher.first_lo));
+    const __m256i first_hi = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)matcher.first_hi));
+    const __m256i second_lo = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)matcher.second_lo));
+    const __m256i second_hi = _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)matcher.second_hi));
+
+    size_t pos = 0;
+    for (; pos + 33 <= length; pos += 32)
+    {
+        const __m256i a = _mm256_loadu_si256((const __m256i*)(text + pos));
+        const __m256i b = _mm256_loadu_si256((const __m256i*)(text + pos + 1));
+        const __m256i first = _mm256_and_si256(
+            _mm256_shuffle_epi8(first_lo, _mm256_and_si256(a, nibble)),
+            _mm256_shuffle_epi8(first_hi, _mm256_and_si256(_mm256_srli_epi16(a, 4), nibble)));
+        const __m256i second = _mm256_and_si256(
+            _mm256_shuffle_epi8(second_lo, _mm256_and_si256(b, nibble)),
+            _mm256_shuffle_epi8(second_hi, _mm256_and_si256(_mm256_srli_epi16(b, 4), nibble)));
+        const __m256i buckets = _mm256_and_si256(first, second);
+
+        u32 mask = ~(u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(buckets, zero));
+        if (!mask)
+            continue;
+
+        alignas(32) u8 bits[32];
+        _mm256_store_si256((__m256i*)bits, buckets);
+        for (; mask; mask &= mask - 1)
+        {
+            const u32 j = scan_ctz(mask);
+            if (verify(matcher, text, length, pos + j, bits[j], wanted, found))
+                return found;
+        }
+    }
+    return find_scalar(matcher, text, length, pos, wanted, found);
+}
+#endif
+//********************************************************************************************
+static multi_match_level_e detect_level(void)
+{
+#if defined(MULTI_MATCH_X86)
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+    __cpuid(info, 1);
+    const bool sse42 = ((info[2] >> 9) & 1) && ((info[2] >> 20) & 1);
+    // AVX registers also need to be saved by the OS
+    const bool avx = ((info[2] >> 27) & 1) && ((info[2] >> 28) & 1) && (_xgetbv(0) & 6) == 6;
+    bool avx2 = false;
+    if (avx && max_leaf >= 7)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] >> 5) & 1;
+    }
+#else
+    __builtin_cpu_init();
+    const bool sse42 = __builtin_cpu_supports("sse4.2");
+    const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2)
+        return MULTI_MATCH_AVX2;
+    if (sse42)
+        return MULTI_MATCH_SSE42;
+#endif
+    return MULTI_MATCH_SCALAR;
+}
+//********************************************************************************************
+multi_match_level_e multi_match_level(void)
+{
+    // On log lines bench_multi_match measures the AVX2 kernel slower than SSE4.2 for every
+    // pattern count, the wider loads rarely fill before a line ends
+    const multi_match_level_e level = multi_match_max_level();
+    return level > MULTI_MATCH_SSE42 ? MULTI_MATCH_SSE42 : level;
+}
+//********************************************************************************************
+multi_match_level_e multi_match_max_level(void)
+{
+    static const multi_match_level_e level = detect_level();
+    return level;
+}
+//********************************************************************************************
+u8 multi_match_find(const multi_match_t& matcher, const char* text, size_t length, u8 wanted)
+{
+    return multi_match_find_with(matcher, text, length, wanted, multi_match_level());
+}
+//********************************************************************************************
+u8 multi_match_find_with(
+    const multi_match_t& matcher,
+    const char* text,
+    size_t length,
+    u8 wanted,
+    multi_match_level_e level)
+{
+    wanted &= matcher.all_flags;
+    u8 found = matcher.empty_flags & wanted;
+    if (found == wanted)
+        return found;
+
+    switch (level)
+    {
+#if defined(MULTI_MATCH_X86)
+    case MULTI_MATCH_AVX2:
+        return find_avx2(matcher, text, length, wanted, found);
+    case MULTI_MATCH_SSE42:
+        return find_sse42(matcher, text, length, wanted, found);
+#endif
+    default:
+        return find_scalar(matcher, text, length, 0, wanted, found);
+    }
+}
+//********************************************************************************************
@@ -0,0 +1,363 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#include <chrono>
+#include <string.h>
+#include <string>
+#include <vector>
+// INTERNAL INCLUDES
+#include "process_capture.h"
+#include "log_parser.h"
+
+#if !defined(_WIN32)
+extern char** environ;
+#endif
+
+#define CAPTURE_READ_SIZE (64 * 1024)
+// Longest line kept together, anything longer is split
+#define CAPTURE_MAX_LINE (1024 * 1024)
+
+static const char* stream_names[2] = { "stdout", "stderr" };
+static const log_severity_e stream_severities[2] = { INFO, WARN };
+
+//********************************************************************************************
+static void parse_output(log_batch_t& batch, const char* data, size_t length, u32 stream)
+{
+    const char* p = data;
+    const char* end = data + length;
+    const u64 now = (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    while (p < end)
+    {
+        const char* newline = (const char*)memchr(p, '\n', end - p);
+        const char* line_end = newline ? newline : end;
+        const char* next = newline ? newline + 1 : end;
+
+        // Console output often has commas too, only lines that start like a record are one
+        log_record_t record;
+        bool valid = false;
+        if (log_looks_like_record(p, line_end))
+            log_parse_line(p, line_end, record, valid);
+        if (valid)
+        {
+            log_batch_add_record(batch, record);
+        }
+        else
+        {
+            // Plain console output, keep it under the stream name
+            if (line_end > p && line_end[-1] == '\r')
+                line_end--;
+            if (line_end > p)
+            {
+                log_batch_add(batch, now, stream_severities[stream],
+                    stream_names[stream], strlen(stream_names[stream]),
+                    p, line_end - p);
+            }
+        }
+
+        p = next;
+    }
+}
+//********************************************************************************************
+static i64 read_pipe(process_capture_t& capture, u32 stream, char* buffer, size_t size)
+{
+#if defined(_WIN32)
+    DWORD read = 0;
+    if (!ReadFile(capture.pipes[stream], buffer, (DWORD)size, &read, NULL))
+        return -1; // broken pipe, the child closed its end or the read was cancelled
+    return read;
+#else
+    while (capture.running.load())
+    {
+        struct pollfd fd = { capture.pipes[stream], POLLIN, 0 };
+        int ready = poll(&fd, 1, 100);
+        if (ready < 0)
+            return -1;
+        if (ready == 0)
+            continue;
+
+        ssize_t read_bytes = read(capture.pipes[stream], buffer, size);
+        return read_bytes > 0 ? read_bytes : -1;
+    }
+    return -1;
+#endif
+}
+//********************************************************************************************
+static void reader_main(process_capture_t* capture, u32 stream, log_ingest_t* ingest)
+{
+    std::vector<char> buffer(CAPTURE_MAX_LINE + CAPTURE_READ_SIZE);
+    size_t pending = 0;
+
+    while (capture->running.load())
+    {
+        i64 read = read_pipe(*capture, stream, buffer.data() + pending, CAPTURE_READ_SIZE);
+        if (read <= 0)
+            break;
+        pending += (size_t)read;
+
+        // Parse every complete line of this chunk in one go, keep the partial tail
+        size_t complete = pending;
+        while (complete > 0 && buffer[complete - 1] != '\n')
+            complete--;
+        if (complete == 0 && pending >= CAPTURE_MAX_LINE)
+            complete = pending;
+        if (complete == 0)
+            continue;
+
+        log_batch_t* batch = log_ingest_acquire_batch(*ingest);
+        parse_output(*batch, buffer.data(), complete, stream);
+        log_ingest_publish(*ingest, batch);
+
+        memmove(buffer.data(), buffer.data() + complete, pending - complete);
+        pending -= complete;
+    }
+
+    if (pending > 0)
+    {
+        log_batch_t* batch = log_ingest_acquire_batch(*ingest);
+        parse_output(*batch, buffer.data(), pending, stream);
+        log_ingest_publish(*ingest, batch);
+    }
+
+    capture->reader_done[stream].store(true);
+}
+//********************************************************************************************
+bool process_capture_start(
+    process_capture_t& capture,
+    const char* application,
+    const char* command_line,
+    log_ingest_t& ingest)
+{
+#if defined(_WIN32)
+    SECURITY_ATTRIBUTES sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.nLength = sizeof(sa);
+    sa.bInheritHandle = TRUE;
+
+    HANDLE write_ends[2] = { NULL, NULL };
+    for (u32 i = 0; i < 2; ++i)
+    {
+        HANDLE read_end = NULL;
+        if (!CreatePipe(&read_end, &write_ends[i], &sa, 0))
+        {
+            if (write_ends[0])
+                CloseHandle(write_ends[0]);
+            process_capture_stop(capture);
+            return false;
+        }
+        // Only the write end is inherited by the child
+        SetHandleInformation(read_end, HANDLE_FLAG_INHERIT, 0);
+        capture.pipes[i] = read_end;
+    }
+
+    STARTUPINFOA si;
+    memset(&si, 0, sizeof(si));
+    si.cb = sizeof(si);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = NULL;
+    si.hStdOutput = write_ends[0];
+    si.hStdError = write_ends[1];
+
+    PROCESS_INFORMATION pi;
+    memset(&pi, 0, sizeof(pi));
+
+    std::string args = command_line;
+    BOOL created = CreateProcessA(
+        application,
+        &args[0],
+        NULL, NULL,
+        TRUE,
+        0,
+        NULL, NULL,
+        &si,
+        &pi);
+
+    // Our copies of the write ends must go, otherwise the pipes never report EOF
+    CloseHandle(write_ends[0]);
+    CloseHandle(write_ends[1]);
+
+    if (!created)
+    {
+        process_capture_stop(capture);
+        return false;
+    }
+
+    CloseHandle(pi.hThread);
+    capture.process = pi.hProcess;
+#else
+    int fds[2][2];
+    for (u32 i = 0; i < 2; ++i)
+    {
+        if (pipe(fds[i]) != 0)
+        {
+            if (i > 0)
+                close(fds[0][1]);
+            process_capture_stop(capture);
+            return false;
+        }
+        capture.pipes[i] = fds[i][0];
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    for (u32 i = 0; i < 2; ++i)
+    {
+        posix_spawn_file_actions_addclose(&actions, fds[i][0]);
+        posix_spawn_file_actions_adddup2(&actions, fds[i][1], i == 0 ? STDOUT_FILENO : STDERR_FILENO);
+        posix_spawn_file_actions_addclose(&actions, fds[i][1]);
+    }
+
+    // Split the command line on spaces, quoting is not supported
+    std::vector<std::string> words;
+    const char* p = command_line;
+    while (*p)
+    {
+        while (*p == ' ')
+            p++;
+        const char* word = p;
+        while (*p && *p != ' ')
+            p++;
+        if (p > word)
+            words.emplace_back(word, p - word);
+    }
+    std::vector<char*> argv;
+    for (size_t i = 0; i < words.size(); ++i)
+        argv.push_back(&words[i][0]);
+    argv.push_back(NULL);
+
+    pid_t pid = 0;
+    int result = posix_spawnp(&pid, application, &actions, NULL, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+
+    close(fds[0][1]);
+    close(fds[1][1]);
+
+    if (result != 0)
+    {
+        process_capture_stop(capture);
+        return false;
+    }
+    capture.pid = pid;
+#endif
+
+    capture.running.store(true);
+    for (u32 i = 0; i < 2; ++i)
+    {
+        capture.reader_done[i].store(false);
+        capture.readers[i] = std::thread(reader_main, &capture, i, &ingest);
+    }
+    return true;
+}
+//********************************************************************************************
+bool process_capture_running(process_capture_t& capture)
+{
+#if defined(_WIN32)
+    return capture.process && WaitForSingleObject(capture.process, 0) == WAIT_TIMEOUT;
+#else
+    if (capture.pid <= 0)
+        return false;
+
+    int status = 0;
+    if (waitpid(capture.pid, &status, WNOHANG) == 0)
+        return true;
+
+    capture.pid = 0; // exited and reaped
+    return false;
+#endif
+}
+//********************************************************************************************
+void process_capture_kill(process_capture_t& capture)
+{
+#if defined(_WIN32)
+    if (capture.process)
+        TerminateProcess(capture.process, 0);
+#else
+    if (capture.pid > 0)
+        kill(capture.pid, SIGTERM);
+#endif
+}
+//********************************************************************************************
+void process_capture_stop(process_capture_t& capture)
+{
+    // Once the child is gone the readers run into EOF on their own, give them a moment
+    // to ingest what is still buffered in the pipes before abandoning them
+    if (!process_capture_running(capture))
+    {
+        for (u32 wait = 0; wait < 1000; ++wait)
+        {
+            if ((!capture.readers[0].joinable() || capture.reader_done[0].load()) &&
+                (!capture.readers[1].joinable() || capture.reader_done[1].load()))
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    capture.running.store(false);
+
+    for (u32 i = 0; i < 2; ++i)
+    {
+        if (!capture.readers[i].joinable())
+            continue;
+
+#if defined(_WIN32)
+        // A child that is still alive keeps ReadFile blocked, cancel until the reader notices
+        while (!capture.reader_done[i].load())
+        {
+            CancelSynchronousIo((HANDLE)capture.readers[i].native_handle());
+            Sleep(1);
+        }
+#endif
+        capture.readers[i].join();
+    }
+
+#if defined(_WIN32)
+    for (u32 i = 0; i < 2; ++i)
+    {
+        if (capture.pipes[i])
+            CloseHandle(capture.pipes[i]);
+        capture.pipes[i] = NULL;
+    }
+    if (capture.process)
+        CloseHandle(capture.process);
+    capture.process = NULL;
+#else
+    for (u32 i = 0; i < 2; ++i)
+    {
+        if (capture.pipes[i] >= 0)
+            close(capture.pipes[i]);
+        capture.pipes[i] = -1;
+    }
+    process_capture_running(capture); // reap if it already exited
+    capture.pid = 0;
+#endif
+}
+//********************************************************************************************
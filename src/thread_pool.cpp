@@ -0,0 +1,121 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#include <atomic>
+// INTERNAL INCLUDES
+#include "thread_pool.h"
+
+//********************************************************************************************
+static void worker_main(thread_pool_t* pool)
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(pool->mutex);
+            pool->wake.wait(lock, [pool] { return pool->stopping || !pool->tasks.empty(); });
+            if (pool->tasks.empty())
+                return; // stopping and drained
+            task = std::move(pool->tasks.front());
+            pool->tasks.pop_front();
+        }
+        task();
+    }
+}
+//********************************************************************************************
+void thread_pool_start(thread_pool_t& pool, u32 threads)
+{
+    if (threads == 0)
+        threads = 1;
+
+    pool.stopping = false;
+    for (u32 i = 0; i < threads; ++i)
+        pool.workers.emplace_back(worker_main, &pool);
+}
+//********************************************************************************************
+void thread_pool_stop(thread_pool_t& pool)
+{
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.stopping = true;
+    }
+    pool.wake.notify_all();
+
+    for (size_t i = 0; i < pool.workers.size(); ++i)
+        pool.workers[i].join();
+    pool.workers.clear();
+}
+//********************************************************************************************
+void thread_pool_submit(thread_pool_t& pool, std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.tasks.push_back(std::move(task));
+    }
+    pool.wake.notify_one();
+}
+//********************************************************************************************
+void thread_pool_parallel_for(thread_pool_t& pool, u32 count, const std::function<void(u32)>& fn)
+{
+    std::atomic<u32> next(0);
+    std::mutex done_mutex;
+    std::condition_variable done;
+
+    u32 helpers = (u32)pool.workers.size();
+    if (helpers > count)
+        helpers = count;
+    u32 remaining = helpers;
+
+    // Every helper keeps taking indices until none are left
+    for (u32 t = 0; t < helpers; ++t)
+    {
+        thread_pool_submit(pool, [&]() {
+            for (u32 i = next++; i < count; i = next++)
+                fn(i);
+
+            std::lock_guard<std::mutex> lock(done_mutex);
+            if (--remaining == 0)
+                done.notify_one();
+        });
+    }
+
+    for (u32 i = next++; i < count; i = next++)
+        fn(i);
+
+    std::unique_lock<std::mutex> lock(done_mutex);
+    done.wait(lock, [&] { return remaining == 0; });
+}
+//********************************************************************************************
+thread_pool_t& thread_pool_shared(void)
+{
+    // Never destroyed, idle workers simply end with the process
+    static thread_pool_t* pool = NULL;
+    static std::once_flag started;
+    std::call_once(started, [] {
+        pool = new thread_pool_t();
+        u32 threads = std::thread::hardware_concurrency();
+        // The calling thread takes part in parallel_for as well
+        thread_pool_start(*pool, threads > 1 ? threads - 1 : 1);
+    });
+    return *pool;
+}
+//********************************************************************************************
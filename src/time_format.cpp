@@ -0,0 +1,143 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+ // EXTERNAL INCLUDES
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+// INTERNAL INCLUDES
+#include "time_format.h"
+
+//********************************************************************************************
+static void format_prefix(i64 minute, char* prefix)
+{
+    time_t start = (time_t)(minute * 60);
+    struct tm tm_info;
+#if defined(_WIN32)
+    localtime_s(&tm_info, &start);
+#else
+    localtime_r(&start, &tm_info);
+#endif
+    char buffer[32];
+    strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:", &tm_info);
+    memcpy(prefix, buffer, TIME_PREFIX_LENGTH);
+}
+//********************************************************************************************
+void time_format_set_precision(time_format_cache_t& cache, time_precision_e precision)
+{
+    if (cache.precision == precision)
+        return;
+
+    cache.precision = precision;
+    for (u32 i = 0; i < TIME_CACHE_ROWS; ++i)
+        cache.rows[i].id = ~0ull;
+}
+//********************************************************************************************
+void time_format(time_format_cache_t& cache, u64 timestamp, char* text)
+{
+    // Local time offsets are whole minutes, so the seconds never change the prefix
+    const u64 ns_per_minute = 60 * 1000000000ull;
+    const i64 minute = (i64)(timestamp / ns_per_minute);
+    time_minute_t& entry = cache.minutes[minute & (TIME_CACHE_MINUTES - 1)];
+    if (entry.minute != minute)
+    {
+        format_prefix(minute, entry.prefix);
+        entry.minute = minute;
+    }
+
+    const u64 rest = timestamp - (u64)minute * ns_per_minute;
+    const u32 seconds = (u32)(rest / 1000000000);
+    memcpy(text, entry.prefix, TIME_PREFIX_LENGTH);
+    text[TIME_PREFIX_LENGTH] = (char)('0' + seconds / 10);
+    text[TIME_PREFIX_LENGTH + 1] = (char)('0' + seconds % 10);
+
+    u32 digits = 0;
+    u32 fraction = (u32)(rest % 1000000000);
+    if (cache.precision == TIME_MILLISECONDS)
+    {
+        digits = 3;
+        fraction /= 1000000;
+    }
+    else if (cache.precision == TIME_MICROSECONDS)
+    {
+        digits = 6;
+        fraction /= 1000;
+    }
+
+    char* end = text + TIME_TEXT_LENGTH;
+    if (digits)
+    {
+        *end = '.';
+        end += digits + 1;
+        for (u32 i = 0; i < digits; ++i)
+        {
+            end[-1 - (i32)i] = (char)('0' + fraction % 10);
+            fraction /= 10;
+        }
+    }
+    *end = '\0';
+}
+//********************************************************************************************
+const char* time_format_row(time_format_cache_t& cache, u64 id, u64 timestamp)
+{
+    time_row_t& row = cache.rows[id & (TIME_CACHE_ROWS - 1)];
+    if (row.id != id || row.timestamp != timestamp)
+    {
+        time_format(cache, timestamp, row.text);
+        row.id = id;
+        row.timestamp = timestamp;
+        row.has_delta = false;
+    }
+    return row.text;
+}
+//********************************************************************************************
+const char* time_format_row_delta(time_format_cache_t& cache, u64 id, i64 delta)
+{
+    time_row_t& row = cache.rows[id & (TIME_CACHE_ROWS - 1)];
+    if (row.id != id)
+    {
+        // Not remembered, still format it but keep the slot for its owner
+        time_format_delta(delta, cache.delta_text);
+        return cache.delta_text;
+    }
+    if (!row.has_delta || row.delta != delta)
+    {
+        time_format_delta(delta, row.delta_text);
+        row.delta = delta;
+        row.has_delta = true;
+    }
+    return row.delta_text;
+}
+//********************************************************************************************
+void time_format_delta(i64 delta, char* text)
+{
+    const char sign = delta < 0 ? '-' : '+';
+    const u64 magnitude = delta < 0 ? 0 - (u64)delta : (u64)delta;
+    if (magnitude < 1000)
+        snprintf(text, TIME_DELTA_SIZE, "%c%llu ns", sign, (unsigned long long)magnitude);
+    else if (magnitude < 1000000)
+        snprintf(text, TIME_DELTA_SIZE, "%c%.3f us", sign, magnitude / 1e3);
+    else if (magnitude < 1000000000)
+        snprintf(text, TIME_DELTA_SIZE, "%c%.3f ms", sign, magnitude / 1e6);
+    else
+        snprintf(text, TIME_DELTA_SIZE, "%c%.3f s", sign, magnitude / 1e9);
+}
+//********************************************************************************************
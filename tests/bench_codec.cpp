@@ -0,0 +1,79 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+ // EXTERNAL INCLUDES
+#include <stdio.h>
+#include <string>
+#include <vector>
+// INTERNAL INCLUDES
+#include "lz_block.h"
+#include "test.h"
+
+#define BENCH_BYTES (32 * 1024 * 1024)
+#define BENCH_BLOCK (1024 * 1024)
+#define BENCH_RUNS 3
+
+//********************************************************************************************
+// Segment sized blocks of log content, the way cold segments and .bspy blocks are packed
+BENCH(bench_lz_block)
+{
+    std::string text;
+    for (u32 i = 0; text.size() < BENCH_BYTES; i++)
+        text += "render: frame " + std::to_string(i) + " took " + std::to_string(i % 977) + " us, queue depth " +
+            std::to_string(i % 13) + "\n";
+
+    const size_t blocks = text.size() / BENCH_BLOCK;
+    std::vector<std::vector<char>> packed(blocks);
+    std::vector<size_t> sizes(blocks);
+    std::vector<char> unpacked(BENCH_BLOCK);
+
+    double best_compress = 1e30;
+    double best_decompress = 1e30;
+    size_t total = 0;
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        total = 0;
+        for (size_t b = 0; b < blocks; b++)
+        {
+            packed[b].resize(lz_compress_bound(BENCH_BLOCK));
+            sizes[b] = lz_compress(text.data() + b * BENCH_BLOCK, BENCH_BLOCK, packed[b].data(), packed[b].size());
+            total += sizes[b];
+        }
+        double seconds = bench_seconds(start);
+        if (seconds < best_compress)
+            best_compress = seconds;
+
+        start = std::chrono::steady_clock::now();
+        for (size_t b = 0; b < blocks; b++)
+            CHECK(lz_decompress(packed[b].data(), sizes[b], unpacked.data(), BENCH_BLOCK));
+        seconds = bench_seconds(start);
+        if (seconds < best_decompress)
+            best_decompress = seconds;
+    }
+
+    const double bytes = (double)(blocks * BENCH_BLOCK);
+    bench_report("lz compress", best_compress, bytes, (double)blocks);
+    bench_report("lz decompress", best_decompress, bytes, (double)blocks);
+    printf("  ratio %.2f\n", bytes / (double)total);
+}
+//********************************************************************************************
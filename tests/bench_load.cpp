@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+ // EXTERNAL INCLUDES
+#include <stdio.h>
+#include <string>
+// INTERNAL INCLUDES
+#include "log_file.h"
+#include "test.h"
+
+#define BENCH_CSV "bspy_bench_load.csv"
+#define BENCH_BSPY "bspy_bench_load.bspy"
+#define BENCH_BYTES (64 * 1024 * 1024)
+#define BENCH_RUNS 3
+
+//********************************************************************************************
+static size_t write_bench_csv(const char* filename)
+{
+    static const char* origins[] = { "main", "render", "audio", "network", "physics" };
+    static const char* severities[] = { "INFO", "DEBUG", "WARNING", "TRACE" };
+
+    FILE* file = fopen(filename, "wb");
+    size_t size = (size_t)fprintf(file, "Timestamp,Severity,Origin,Content\n");
+    u64 timestamp = 1700000000000000000ull;
+    for (u32 i = 0; size < BENCH_BYTES; i++, timestamp += 1733)
+    {
+        size += (size_t)fprintf(file, "%llu,%s,%s,Frame %u took %u us, %u draw calls\n",
+            (unsigned long long)timestamp, severities[i % 4], origins[i % 5], i, i % 977, i % 131);
+    }
+    fclose(file);
+    return size;
+}
+//********************************************************************************************
+static void bench_file(const char* what, const char* filename, double bytes)
+{
+    double best = 1e30;
+    u64 rows = 0;
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        log_store_t logs;
+        auto start = std::chrono::steady_clock::now();
+        load_logs_from_file(filename, logs);
+        double seconds = bench_seconds(start);
+        if (seconds < best)
+            best = seconds;
+        rows = log_store_size(logs);
+    }
+    bench_report(what, best, bytes, (double)rows);
+}
+//********************************************************************************************
+BENCH(bench_load)
+{
+    size_t csv_size = write_bench_csv(BENCH_CSV);
+
+    // Throughput is measured against the CSV size for both formats to compare them
+    log_store_t logs;
+    load_logs_from_file(BENCH_CSV, logs);
+    log_snapshot_t snapshot;
+    log_store_snapshot(logs, snapshot);
+    save_logs_to_file(BENCH_BSPY, snapshot, NULL);
+
+    bench_file("load csv", BENCH_CSV, (double)csv_size);
+    bench_file("load bspy", BENCH_BSPY, (double)csv_size);
+
+    remove(BENCH_CSV);
+    remove(BENCH_BSPY);
+}
+//********************************************************************************************
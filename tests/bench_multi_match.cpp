@@ -0,0 +1,123 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+ // EXTERNAL INCLUDES
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+// INTERNAL INCLUDES
+#include "multi_match.h"
+#include "test.h"
+#include "text_scan.h"
+
+#define BENCH_LINES 200000
+#define BENCH_RUNS 3
+
+static const char* level_names[] = { "scalar", "sse4.2", "avx2" };
+static volatile u64 bench_hits;     // keeps the searches from being optimised away
+
+//********************************************************************************************
+static void make_lines(std::vector<std::string>& lines, size_t& bytes)
+{
+    static const char* words[] = { "frame", "render", "upload", "texture", "shader", "queue",
+        "submit", "present", "fence", "buffer", "compile", "pipeline", "warning", "slow" };
+    char line[256];
+    bytes = 0;
+    for (u32 i = 0; i < BENCH_LINES; i++)
+    {
+        int length = snprintf(line, sizeof(line), "%s %s took %u us on %s, %u draws in %s",
+            words[i % 14], words[(i * 7) % 14], i % 977, words[(i * 3) % 14], i % 131, words[(i * 5) % 14]);
+        lines.emplace_back(line, (size_t)length);
+        bytes += (size_t)length;
+    }
+}
+//********************************************************************************************
+static void bench_patterns(const std::vector<std::string>& lines, size_t bytes, const char** patterns, u32 count)
+{
+    multi_match_t matcher;
+    multi_match_clear(matcher);
+    for (u32 i = 0; i < count; i++)
+        multi_match_add(matcher, patterns[i], strlen(patterns[i]), (u8)(1u << (i % 8)));
+    multi_match_build(matcher, false);
+
+    char what[64];
+    for (int level = MULTI_MATCH_SCALAR; level <= (int)multi_match_max_level(); level++)
+    {
+        double best = 1e30;
+        u64 hits = 0;
+        for (int run = 0; run < BENCH_RUNS; run++)
+        {
+            hits = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < lines.size(); i++)
+                hits += multi_match_find_with(matcher, lines[i].data(), lines[i].size(), 0xFF, (multi_match_level_e)level) != 0;
+            double seconds = bench_seconds(start);
+            if (seconds < best)
+                best = seconds;
+            bench_hits = hits;
+        }
+        snprintf(what, sizeof(what), "%u patterns, %s", count, level_names[level]);
+        bench_report(what, best, (double)bytes, (double)lines.size());
+    }
+
+    // Every pattern searched on its own, what the matcher replaces
+    double best = 1e30;
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        u64 hits = 0;
+        for (size_t i = 0; i < lines.size(); i++)
+        {
+            for (u32 p = 0; p < count; p++)
+            {
+                if (scan_find_text(lines[i].data(), lines[i].size(), patterns[p], strlen(patterns[p])))
+                {
+                    hits++;
+                    break;
+                }
+            }
+        }
+        double seconds = bench_seconds(start);
+        if (seconds < best)
+            best = seconds;
+        bench_hits = hits;
+    }
+    snprintf(what, sizeof(what), "%u patterns, one by one", count);
+    bench_report(what, best, (double)bytes, (double)lines.size());
+}
+//********************************************************************************************
+BENCH(bench_multi_match)
+{
+    std::vector<std::string> lines;
+    size_t bytes;
+    make_lines(lines, bytes);
+
+    static const char* one[] = { "pipeline" };
+    static const char* few[] = { "pipeline", "stall", "error", "fence" };
+    static const char* many[] = { "pipeline", "stall", "error", "fence", "timeout", "crash", "leak",
+        "overflow", "denied", "missing", "invalid", "corrupt", "retry", "abort", "lost", "hang" };
+    bench_patterns(lines, bytes, one, 1);
+    bench_patterns(lines, bytes, few, 4);
+    bench_patterns(lines, bytes, many, 16);
+}
+//********************************************************************************************
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+ // EXTERNAL INCLUDES
+#include <stdio.h>
+#include <string>
+// INTERNAL INCLUDES
+#include "log_parser.h"
+#include "test.h"
+
+#define BENCH_BYTES (32 * 1024 * 1024)
+#define BENCH_RUNS 3
+
+//********************************************************************************************
+static void bench_lines(const char* what, const std::string& text)
+{
+    double best = 1e30;
+    u32 rows = 0;
+    log_batch_t batch;
+    for (int run = 0; run < BENCH_RUNS; run++)
+    {
+        log_batch_clear(batch);
+        auto start = std::chrono::steady_clock::now();
+        rows = log_parse_lines(text.data(), text.size(), batch);
+        double seconds = bench_seconds(start);
+        if (seconds < best)
+            best = seconds;
+    }
+    bench_report(what, best, (double)text.size(), (double)rows);
+}
+//********************************************************************************************
+BENCH(bench_parse_lines)
+{
+    std::string plain;
+    std::string quoted;
+    char line[160];
+    for (u32 i = 0; plain.size() < BENCH_BYTES; i++)
+    {
+        snprintf(line, sizeof(line), "%llu,INFO,render,Frame %u took %u us, %u draw calls\n",
+            1700000000000000000ull + i, i, i % 977, i % 131);
+        plain += line;
+        snprintf(line, sizeof(line), "%llu,WARN,\"render, gpu\",\"Frame %u \"\"late\"\"\nby %u us\"\n",
+            1700000000000000000ull + i, i, i % 977);
+        quoted += line;
+    }
+
+    bench_lines("parse plain lines", plain);
+    bench_lines("parse quoted lines", quoted);
+}
+//********************************************************************************************
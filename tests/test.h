@@ -0,0 +1,81 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+#ifndef TEST_H
+#define TEST_H
+
+// EXTERNAL INCLUDES
+#include <chrono>
+#include <stdio.h>
+
+//********************************************************************************************
+// Minimal self registering cases. TEST cases run by default, BENCH cases with --bench.
+typedef struct test_case_t
+{
+    const char* name;
+    void (*function)(void);
+    bool bench;
+    test_case_t* next;
+} test_case_t;
+
+extern int test_failures;
+void test_register(test_case_t& test);
+
+//********************************************************************************************
+struct test_registrar_t
+{
+    explicit test_registrar_t(test_case_t& test) { test_register(test); }
+};
+
+#define TEST_CASE(name, bench) \
+    static void name(void); \
+    static test_case_t name##_case = { #name, name, bench, NULL }; \
+    static test_registrar_t name##_registrar(name##_case); \
+    static void name(void)
+
+#define TEST(name) TEST_CASE(name, false)
+#define BENCH(name) TEST_CASE(name, true)
+
+#define CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            printf("  %s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+            test_failures++; \
+        } \
+    } while (0)
+
+//********************************************************************************************
+inline double bench_seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+//********************************************************************************************
+inline void bench_report(const char* what, double seconds, double bytes, double items)
+{
+    printf("  %-32s %8.1f MB/s %12.0f items/s\n", what,
+        bytes / seconds / (1024.0 * 1024.0), items / seconds);
+}
+//********************************************************************************************
+
+#endif // TEST_H
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+ // EXTERNAL INCLUDES
+#include <random>
+#include <string.h>
+#include <string>
+#include <vector>
+// INTERNAL INCLUDES
+#include "csv_codec.h"
+#include "lz_block.h"
+#include "test.h"
+
+//********************************************************************************************
+static bool lz_round_trip(const std::string& text)
+{
+    std::vector<char> packed(lz_compress_bound(text.size()));
+    size_t size = lz_compress(text.data(), text.size(), packed.data(), packed.size());
+    if (size == 0)
+        return text.empty();
+
+    std::vector<char> unpacked(text.size());
+    return lz_decompress(packed.data(), size, unpacked.data(), unpacked.size()) &&
+        memcmp(unpacked.data(), text.data(), text.size()) == 0;
+}
+//********************************************************************************************
+TEST(codec_lz_round_trip)
+{
+    std::mt19937 random(99);
+    std::string noise(100000, ' ');
+    for (size_t i = 0; i < noise.size(); i++)
+        noise[i] = (char)random();
+
+    std::string lines;
+    for (u32 i = 0; lines.size() < 200000; i++)
+        lines += "render: frame " + std::to_string(i) + " took " + std::to_string(i % 97) + " us\n";
+
+    CHECK(lz_round_trip("a"));
+    CHECK(lz_round_trip(std::string(70000, 'x')));
+    CHECK(lz_round_trip(noise));
+    CHECK(lz_round_trip(lines));
+
+    // A truncated or short destination must be refused, not overrun
+    std::vector<char> packed(lz_compress_bound(lines.size()));
+    size_t size = lz_compress(lines.data(), lines.size(), packed.data(), packed.size());
+    std::vector<char> unpacked(lines.size());
+    CHECK(size > 0 && size < lines.size() / 2);
+    CHECK(!lz_decompress(packed.data(), size / 2, unpacked.data(), unpacked.size()));
+    CHECK(!lz_decompress(packed.data(), size, unpacked.data(), unpacked.size() - 1));
+}
+//********************************************************************************************
+TEST(codec_csv_unescape)
+{
+    char text[32];
+    strcpy(text, "say \"\"hi\"\"");
+    u32 length = csv_unescape(text, text, strlen(text));
+    CHECK(std::string(text, length) == "say \"hi\"");
+
+    strcpy(text, "\"\"\"\"");
+    length = csv_unescape(text, text, strlen(text));
+    CHECK(std::string(text, length) == "\"\"");
+
+    strcpy(text, "plain");
+    CHECK(csv_unescape(text, text, strlen(text)) == 5);
+}
+//********************************************************************************************
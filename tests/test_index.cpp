@@ -0,0 +1,68 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+ // EXTERNAL INCLUDES
+#include <string>
+#include <thread>
+// INTERNAL INCLUDES
+#include "log_index.h"
+#include "test.h"
+
+//********************************************************************************************
+// Runs log_index_update until no job is left running
+static void wait_for_index_jobs(log_store_t& logs)
+{
+    log_index_update(logs);
+    for (size_t j = 0; j < logs.index_jobs.size(); j++)
+    {
+        while (!logs.index_jobs[j]->done.load())
+            std::this_thread::yield();
+    }
+    log_index_update(logs);
+}
+//********************************************************************************************
+TEST(index_waits_for_snapshots)
+{
+    log_store_t logs;
+    for (u32 i = 0; i < LOG_SEGMENT_CAPACITY + 10; i++)
+    {
+        const std::string content = "frame " + std::to_string(i) + " rendered";
+        log_store_append(logs, i, INFO, "main", 4, content.data(), content.size());
+    }
+    CHECK(logs.segments.size() == 2);
+
+    // A refilter pass reads the segment through its snapshot, the index must not change it
+    log_snapshot_t snapshot;
+    log_store_snapshot(logs, snapshot);
+    wait_for_index_jobs(logs);
+    CHECK(!logs.segments[0]->indexed);
+    CHECK(logs.index_jobs.size() == 1);
+
+    snapshot.segments.clear();
+    log_index_update(logs);
+    CHECK(logs.segments[0]->indexed);
+    CHECK(logs.index_jobs.empty());
+
+    log_group_set_t groups;
+    CHECK(log_index_candidates(*logs.segments[0], "rendered", 8, groups));
+}
+//********************************************************************************************
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+ // EXTERNAL INCLUDES
+#include <algorithm>
+#include <stdio.h>
+#include <string>
+// INTERNAL INCLUDES
+#include "log_file.h"
+#include "test.h"
+
+#define TEST_FILE "bspy_test_load.csv"
+
+//********************************************************************************************
+static void write_file(const char* filename, const std::string& text)
+{
+    FILE* file = fopen(filename, "wb");
+    fwrite(text.data(), 1, text.size(), file);
+    fclose(file);
+}
+//********************************************************************************************
+static void append_record(std::string& text, u64 timestamp, const char* origin, const char* content)
+{
+    char line[64];
+    snprintf(line, sizeof(line), "%llu,INFO,%s,", (unsigned long long)timestamp, origin);
+    text += line;
+    text += content;
+    text += '\n';
+}
+//********************************************************************************************
+static bool has_origin(const log_store_t& logs, const char* origin)
+{
+    return std::find(logs.origin_names.begin(), logs.origin_names.end(), origin) != logs.origin_names.end();
+}
+//********************************************************************************************
+TEST(load_csv_round_trip)
+{
+    std::string text = "Timestamp,Severity,Origin,Content\n";
+    append_record(text, 1700000000000000000ull, "main", "first");
+    append_record(text, 1700000000000000001ull, "render", "\"quoted, with \"\"quotes\"\"\nand a newline\"");
+    append_record(text, 1700000000000000002ull, "main", "last");
+    write_file(TEST_FILE, text);
+
+    log_store_t logs;
+    CHECK(load_logs_from_csv(TEST_FILE, logs));
+    CHECK(log_store_size(logs) == 3);
+
+    log_entry_ref_t entry;
+    CHECK(log_store_get(logs, logs.first_id + 1, entry));
+    CHECK(entry.timestamp == 1700000000000000001ull);
+    CHECK(log_store_origin(logs, entry.origin) == "render");
+    CHECK(std::string(entry.content, entry.content_length) == "quoted, with \"quotes\"\nand a newline");
+
+    log_store_clear(logs);
+    remove(TEST_FILE);
+}
+//********************************************************************************************
+TEST(load_csv_reparsed_chunk_keeps_origins)
+{
+    // Large enough for two chunks, the second guessed start lands inside quoted content
+    // whose lines look like records of a made up origin
+    const size_t target = 9 * 1024 * 1024;
+    std::string text = "Timestamp,Severity,Origin,Content\n";
+    u64 timestamp = 1700000000000000000ull;
+    bool quoted = false;
+    while (text.size() < target)
+    {
+        if (!quoted && text.size() > target / 2 - 64 * 1024)
+        {
+            std::string content = "\"";
+            while (content.size() < 256 * 1024)
+                content += "1700000000000000000,INFO,bogus,inside quotes\n";
+            content += '"';
+            append_record(text, timestamp++, "main", content.c_str());
+            quoted = true;
+        }
+        append_record(text, timestamp, timestamp & 1 ? "main" : "render", "regular record content");
+        timestamp++;
+    }
+    write_file(TEST_FILE, text);
+
+    log_store_t logs;
+    CHECK(load_logs_from_csv(TEST_FILE, logs));
+    CHECK(log_store_size(logs) == timestamp - 1700000000000000000ull);
+    CHECK(has_origin(logs, "main"));
+    CHECK(has_origin(logs, "render"));
+    CHECK(!has_origin(logs, "bogus"));
+
+    log_store_clear(logs);
+    remove(TEST_FILE);
+}
+//********************************************************************************************
+TEST(load_csv_record_spanning_chunks)
+{
+    // A quoted record longer than a whole chunk, the middle chunk starts and ends inside it
+    // and the next one guesses its start inside it as well
+    const size_t chunk = 4 * 1024 * 1024;
+    std::string text = "Timestamp,Severity,Origin,Content\n";
+    u64 timestamp = 1700000000000000000ull;
+    while (text.size() < chunk / 4)
+        append_record(text, timestamp++, "main", "regular record content");
+
+    std::string content = "\"";
+    while (content.size() < chunk * 9 / 4)
+        content += "1700000000000000000,INFO,bogus,inside quotes\n";
+    content += '"';
+    append_record(text, timestamp++, "render", content.c_str());
+
+    while (text.size() < chunk * 7 / 2)
+        append_record(text, timestamp++, "main", "regular record content");
+    write_file(TEST_FILE, text);
+
+    log_store_t logs;
+    CHECK(load_logs_from_csv(TEST_FILE, logs));
+    CHECK(log_store_size(logs) == timestamp - 1700000000000000000ull);
+    CHECK(!has_origin(logs, "bogus"));
+
+    bool found = false;
+    for (u64 id = logs.first_id; id < logs.next_id; id++)
+    {
+        log_entry_ref_t entry;
+        log_store_get(logs, id, entry);
+        if (log_store_origin(logs, entry.origin) == "render")
+            found = entry.content_length == content.size() - 2;
+    }
+    CHECK(found);
+
+    log_store_clear(logs);
+    remove(TEST_FILE);
+}
+//********************************************************************************************
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+ // EXTERNAL INCLUDES
+#include <stdio.h>
+#include <string.h>
+// INTERNAL INCLUDES
+#include "test.h"
+
+int test_failures = 0;
+static test_case_t* first_case = NULL;
+static test_case_t* last_case = NULL;
+
+//********************************************************************************************
+void test_register(test_case_t& test)
+{
+    // Keep file order, registration runs in static initialization order
+    if (last_case)
+        last_case->next = &test;
+    else
+        first_case = &test;
+    last_case = &test;
+}
+//********************************************************************************************
+// run_tests [--bench] [name filter]
+int main(int argc, char** argv)
+{
+    bool bench = false;
+    const char* filter = NULL;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--bench") == 0)
+            bench = true;
+        else
+            filter = argv[i];
+    }
+
+    int run = 0;
+    for (test_case_t* test = first_case; test; test = test->next)
+    {
+        if (test->bench != bench || (filter && !strstr(test->name, filter)))
+            continue;
+
+        int failures = test_failures;
+        printf("%s\n", test->name);
+        test->function();
+        if (test_failures != failures)
+            printf("  FAILED\n");
+        run++;
+    }
+
+    printf("%d %s, %d failed checks\n", run, bench ? "benchmarks" : "tests", test_failures);
+    fflush(stdout);
+    return test_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+ // EXTERNAL INCLUDES
+#include <random>
+#include <stdio.h>
+#include <string>
+#include <vector>
+// INTERNAL INCLUDES
+#include "multi_match.h"
+#include "test.h"
+#include "text_scan.h"
+
+//********************************************************************************************
+static std::string fold(const std::string& text)
+{
+    std::string folded = text;
+    for (size_t i = 0; i < folded.size(); i++)
+        folded[i] = scan_fold(folded[i]);
+    return folded;
+}
+//********************************************************************************************
+// Plain search of every pattern on its own
+static u8 reference_find(
+    const std::vector<std::string>& patterns,
+    const std::vector<u8>& flags,
+    const std::string& text,
+    bool ignore_case,
+    u8 wanted)
+{
+    const std::string haystack = ignore_case ? fold(text) : text;
+    u8 found = 0;
+    for (size_t i = 0; i < patterns.size(); i++)
+    {
+        const std::string needle = ignore_case ? fold(patterns[i]) : patterns[i];
+        if (haystack.find(needle) != std::string::npos)
+            found |= flags[i];
+    }
+    return found & wanted;
+}
+//********************************************************************************************
+// Result of every instruction set this CPU runs, all must agree with the reference
+static bool all_levels_agree(const multi_match_t& matcher, const std::string& text, u8 wanted, u8 expected)
+{
+    for (int level = MULTI_MATCH_SCALAR; level <= (int)multi_match_max_level(); level++)
+    {
+        u8 found = multi_match_find_with(matcher, text.data(), text.size(), wanted, (multi_match_level_e)level);
+        if (found != expected)
+        {
+            printf("  level %d found 0x%02x, expected 0x%02x in \"%.40s\"\n", level, found, expected, text.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+//********************************************************************************************
+TEST(multi_match_basic)
+{
+    multi_match_t matcher;
+    multi_match_clear(matcher);
+    multi_match_add(matcher, "error", 5, 1);
+    multi_match_add(matcher, "x", 1, 2);
+    multi_match_add(matcher, "timeout", 7, 4);
+    multi_match_build(matcher, false);
+
+    CHECK(all_levels_agree(matcher, "no match here", 0xFF, 0));
+    CHECK(all_levels_agree(matcher, "an error occurred", 0xFF, 1));
+    CHECK(all_levels_agree(matcher, "ends with x", 0xFF, 2));
+    CHECK(all_levels_agree(matcher, "0123456789012345678901234567890123456789 timeout", 0xFF, 4));
+    CHECK(all_levels_agree(matcher, "error and timeout and x", 0xFF, 7));
+    CHECK(all_levels_agree(matcher, "error and timeout and x", 4, 4));
+    CHECK(all_levels_agree(matcher, "ERROR", 0xFF, 0));
+    CHECK(all_levels_agree(matcher, "", 0xFF, 0));
+
+    multi_match_build(matcher, true);
+    CHECK(all_levels_agree(matcher, "ERROR and TimeOut", 0xFF, 5));
+}
+//********************************************************************************************
+TEST(multi_match_empty_pattern)
+{
+    multi_match_t matcher;
+    multi_match_clear(matcher);
+    multi_match_add(matcher, "", 0, 1);
+    multi_match_add(matcher, "abc", 3, 2);
+    multi_match_build(matcher, false);
+    CHECK(all_levels_agree(matcher, "", 0xFF, 1));
+    CHECK(all_levels_agree(matcher, "xxabc", 0xFF, 3));
+}
+//********************************************************************************************
+TEST(multi_match_random)
+{
+    // Small alphabet so patterns share first bytes and buckets, texts cross the vector widths
+    std::mt19937 random(1234);
+    const char alphabet[] = "abcAB,. \n";
+    auto random_text = [&](size_t length) {
+        std::string text(length, ' ');
+        for (size_t i = 0; i < length; i++)
+            text[i] = alphabet[random() % (sizeof(alphabet) - 1)];
+        return text;
+    };
+
+    u32 mismatches = 0;
+    for (u32 round = 0; round < 2000 && mismatches < 5; round++)
+    {
+        const u32 count = 1 + random() % 24;
+        std::vector<std::string> patterns;
+        std::vector<u8> flags;
+        multi_match_t matcher;
+        multi_match_clear(matcher);
+        for (u32 i = 0; i < count; i++)
+        {
+            patterns.push_back(random_text(1 + random() % 5));
+            flags.push_back((u8)(1u << (random() % 8)));
+            multi_match_add(matcher, patterns[i].data(), patterns[i].size(), flags[i]);
+        }
+        const bool ignore_case = (round & 1) != 0;
+        multi_match_build(matcher, ignore_case);
+
+        const std::string text = random_text(random() % 100);
+        const u8 wanted = (u8)(random() | 1);
+        const u8 expected = reference_find(patterns, flags, text, ignore_case, wanted);
+        if (!all_levels_agree(matcher, text, wanted, expected))
+            mismatches++;
+    }
+    CHECK(mismatches == 0);
+}
+//********************************************************************************************
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+ // EXTERNAL INCLUDES
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+// INTERNAL INCLUDES
+#include "log_bspy.h"
+#include "log_file.h"
+#include "log_parser.h"
+#include "test.h"
+
+#define TEST_FILE "bspy_test_parser"
+
+//********************************************************************************************
+static std::string batch_origin(const log_batch_t& batch, u32 i)
+{
+    return std::string(batch.text.data() + batch.origin_offsets[i], batch.origin_lengths[i]);
+}
+//********************************************************************************************
+static std::string batch_content(const log_batch_t& batch, u32 i)
+{
+    return std::string(batch.text.data() + batch.content_offsets[i], batch.content_lengths[i]);
+}
+//********************************************************************************************
+static u32 parse_text(const char* text, log_batch_t& batch)
+{
+    batch = log_batch_t();
+    return log_parse_lines(text, strlen(text), batch);
+}
+//********************************************************************************************
+TEST(parser_quoted_fields)
+{
+    log_batch_t batch;
+    CHECK(parse_text("1,INFO,\"a,b\",\"x, \"\"y\"\"\r\nz\"\r\n2,WARN,c,plain\n", batch) == 2);
+    CHECK(batch_origin(batch, 0) == "a,b");
+    CHECK(batch_content(batch, 0) == "x, \"y\"\r\nz");
+    CHECK(batch.severities[1] == WARN);
+    CHECK(batch_content(batch, 1) == "plain");
+}
+//********************************************************************************************
+TEST(parser_quoted_origin_with_newline)
+{
+    log_batch_t batch;
+    CHECK(parse_text("1,INFO,\"two\nlines\",content\n2,INFO,next,content\n", batch) == 2);
+    CHECK(batch_origin(batch, 0) == "two\nlines");
+    CHECK(batch_content(batch, 0) == "content");
+    CHECK(batch_origin(batch, 1) == "next");
+}
+//********************************************************************************************
+TEST(parser_unterminated_quote_keeps_records)
+{
+    // The stray quote must not run on to the quoted field two records later
+    log_batch_t batch;
+    CHECK(parse_text("1,INFO,a,\"never closed\n2,INFO,b,plain\n3,INFO,c,\"quoted\"\n", batch) == 3);
+    CHECK(batch_content(batch, 0) == "\"never closed");
+    CHECK(batch_content(batch, 1) == "plain");
+    CHECK(batch_content(batch, 2) == "quoted");
+
+    CHECK(parse_text("1,INFO,\"open origin,content\n2,INFO,\"b\",x\n", batch) == 2);
+    CHECK(batch_origin(batch, 0) == "\"open origin");
+    CHECK(batch_origin(batch, 1) == "b");
+
+    // Unquoted content that merely starts with a quote
+    CHECK(parse_text("1,INFO,a,\"hi\" there\n", batch) == 1);
+    CHECK(batch_content(batch, 0) == "\"hi\" there");
+}
+//********************************************************************************************
+static void check_round_trip(const char* extension)
+{
+    static const char* origins[] = { "plain", "comma,origin", "quote\"origin", "new\nline", "\"leading", "" };
+    static const char* contents[] = {
+        "plain", "a, b", "say \"hi\"", "two\nlines", "crlf\r\nend", "\"leading quote",
+        "trailing quote\"", "\"\"", "1700000000,INFO,looks,like a record\n2,WARN,x,\"y\"", "",
+    };
+    const u32 origin_count = sizeof(origins) / sizeof(origins[0]);
+    const u32 content_count = sizeof(contents) / sizeof(contents[0]);
+
+    log_store_t logs;
+    for (u32 i = 0; i < origin_count * content_count; i++)
+    {
+        const char* origin = origins[i % origin_count];
+        const char* content = contents[i / origin_count];
+        log_store_append(logs, 1700000000000000000ull + i, (log_severity_e)(i % 7),
+            origin, strlen(origin), content, strlen(content));
+    }
+
+    const std::string filename = std::string(TEST_FILE) + extension;
+    log_snapshot_t snapshot;
+    log_store_snapshot(logs, snapshot);
+    CHECK(save_logs_to_file(filename.c_str(), snapshot, NULL));
+
+    log_store_t loaded;
+    CHECK(load_logs_from_file(filename.c_str(), loaded));
+    CHECK(log_store_size(loaded) == log_store_size(logs));
+    for (u64 i = 0; i < log_store_size(logs) && i < log_store_size(loaded); i++)
+    {
+        log_entry_ref_t a;
+        log_entry_ref_t b;
+        log_store_get(logs, logs.first_id + i, a);
+        log_store_get(loaded, loaded.first_id + i, b);
+        // Stop at the first difference, every row after a misread one differs too
+        bool same = a.timestamp == b.timestamp && a.severity == b.severity &&
+            log_store_origin(logs, a.origin) == log_store_origin(loaded, b.origin) &&
+            std::string(a.content, a.content_length) == std::string(b.content, b.content_length);
+        CHECK(same);
+        if (!same)
+        {
+            printf("  first difference at row %llu\n", (unsigned long long)i);
+            break;
+        }
+    }
+
+    log_store_clear(loaded);
+    remove(filename.c_str());
+}
+//********************************************************************************************
+TEST(parser_csv_round_trip)
+{
+    check_round_trip(".csv");
+}
+//********************************************************************************************
+TEST(parser_bspy_round_trip)
+{
+    check_round_trip(".bspy");
+}
+//********************************************************************************************
+TEST(parser_bspy_corrupt_block_keeps_store)
+{
+    log_store_t logs;
+    for (u32 i = 0; i < BSPY_BLOCK_ROWS * 2 + 10; i++)
+        log_store_append(logs, 1700000000000000000ull + i, INFO, "origin", 6, "content", 7);
+
+    const std::string filename = std::string(TEST_FILE) + ".bspy";
+    log_snapshot_t snapshot;
+    log_store_snapshot(logs, snapshot);
+    CHECK(save_logs_to_file(filename.c_str(), snapshot, NULL));
+
+    // A store holding other entries, loading the capture continues its ids
+    log_store_t loaded;
+    log_store_append(loaded, 1, WARN, "before", 6, "kept", 4);
+    CHECK(load_logs_from_file(filename.c_str(), loaded));
+    CHECK(log_store_size(loaded) == log_store_size(logs));
+    CHECK(loaded.first_id == 1);
+    CHECK(log_store_origin(loaded, 0) == "origin");
+
+    // Give the second block an unknown compression in the index
+    FILE* file = fopen(filename.c_str(), "r+b");
+    bspy_trailer_t trailer;
+    CHECK(file && fseek(file, -(long)sizeof(trailer), SEEK_END) == 0 && fread(&trailer, sizeof(trailer), 1, file) == 1);
+    CHECK(trailer.block_count >= 2);
+    const long entry = (long)(trailer.index_offset + sizeof(bspy_index_entry_t) +
+        offsetof(bspy_index_entry_t, header) + offsetof(bspy_block_header_t, compression));
+    const u8 compression = 0xFF;
+    CHECK(file && fseek(file, entry, SEEK_SET) == 0 && fwrite(&compression, 1, 1, file) == 1);
+    if (file)
+        fclose(file);
+
+    log_store_t kept;
+    log_store_append(kept, 1, WARN, "before", 6, "kept", 4);
+    CHECK(!load_logs_from_file(filename.c_str(), kept));
+    CHECK(log_store_size(kept) == 1);
+    CHECK(log_store_origin(kept, 0) == "before");
+
+    log_store_clear(loaded);
+    remove(filename.c_str());
+}
+//********************************************************************************************
+TEST(parser_jsonl_export)
+{
+    log_store_t logs;
+    const char* origin = "bad\xff";
+    const char* content = "\xe2\x82\xac \xf0\x9f\x98\x80 \xc0\xaf \xed\xa0\x80 \"q\"\t\xe2\x82";
+    log_store_append(logs, 1700000000000000001ull, WARN, origin, strlen(origin), content, strlen(content));
+
+    const std::string filename = std::string(TEST_FILE) + ".jsonl";
+    log_snapshot_t snapshot;
+    log_store_snapshot(logs, snapshot);
+    CHECK(save_logs_to_file(filename.c_str(), snapshot, NULL));
+
+    char line[256] = {};
+    FILE* file = fopen(filename.c_str(), "rb");
+    CHECK(file && fread(line, 1, sizeof(line) - 1, file) > 0);
+    if (file)
+        fclose(file);
+    CHECK(strcmp(line, "{\"timestamp\":1700000000000000001,\"severity\":\"WARN\",\"origin\":\"bad\\ufffd\","
+        "\"content\":\"\xe2\x82\xac \xf0\x9f\x98\x80 \\ufffd\\ufffd \\ufffd\\ufffd\\ufffd \\\"q\\\"\\t\\ufffd\\ufffd\"}\n") == 0);
+
+    remove(filename.c_str());
+}
+//********************************************************************************************
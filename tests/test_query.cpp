@@ -0,0 +1,140 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+ // EXTERNAL INCLUDES
+#include <string.h>
+#include <string>
+#include <vector>
+// INTERNAL INCLUDES
+#include "log_bitmap.h"
+#include "log_query.h"
+#include "test.h"
+
+//********************************************************************************************
+static void make_store(log_store_t& logs)
+{
+    static const struct { log_severity_e severity; const char* origin; const char* content; } rows[] = {
+        { INFO, "main", "render frame started" },
+        { WARN, "render", "render() took too long" },
+        { FAIL, "net", "connection timeout after 3s" },
+        { DBUG, "net", "timed out waiting" },
+        { CRIT, "main", "crash in render" },
+        { INFO, "render, gpu", "frame, done" },
+    };
+    for (u32 i = 0; i < sizeof(rows) / sizeof(rows[0]); i++)
+    {
+        log_store_append(logs, (1700000000ull + i) * LOG_NS_PER_SECOND, rows[i].severity,
+            rows[i].origin, strlen(rows[i].origin), rows[i].content, strlen(rows[i].content));
+    }
+}
+//********************************************************************************************
+// Rows of the store matching the compiled query, the way a filter pass evaluates it
+static std::string evaluate(const log_store_t& logs, log_query_t& query)
+{
+    log_query_update_origins(query, logs.origin_names);
+    log_query_plan(query, logs);
+
+    std::string matched;
+    std::vector<char> scratch;
+    for (size_t s = 0; s < logs.segments.size(); s++)
+    {
+        const log_segment_t& segment = *logs.segments[s];
+        const char* text = log_segment_read_text(segment, scratch);
+        u64 rows[LOG_BITMAP_WORDS] = {};
+        for (u32 i = 0; i < segment.count; i++)
+            rows[i / 64] |= (u64)1 << (i & 63);
+        log_query_rows(query, segment, rows);
+        for (u32 i = 0; i < segment.count; i++)
+        {
+            if (((rows[i / 64] >> (i & 63)) & 1) && log_query_match(query, segment, text, i))
+                matched += (char)('0' + segment.first_id + i);
+        }
+    }
+    return matched;
+}
+//********************************************************************************************
+static std::string run(const char* text, bool ignore_case = false, u32 max_edits = 0)
+{
+    log_store_t logs;
+    make_store(logs);
+    log_query_t query;
+    if (!log_query_compile(query, text, ignore_case, max_edits) || !query.active)
+        return "inactive";
+    return evaluate(logs, query);
+}
+//********************************************************************************************
+TEST(query_plain_text_stays_substring_filter)
+{
+    log_query_t query;
+    CHECK(log_query_compile(query, "render", false, 0));
+    CHECK(!query.active);
+    CHECK(log_query_compile(query, "timeout, crash", false, 0));
+    CHECK(!query.active);
+    CHECK(log_query_compile(query, "", false, 0));
+    CHECK(!query.active);
+}
+//********************************************************************************************
+TEST(query_malformed_falls_back_to_text)
+{
+    static const char* texts[] = { "render()", "\"unclosed", "(a OR b", "a)", "/[/", "NOT" };
+    for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++)
+    {
+        log_query_t query;
+        CHECK(!log_query_compile(query, texts[i], false, 0));
+        CHECK(!query.active);
+        CHECK(!query.error.empty());
+    }
+}
+//********************************************************************************************
+TEST(query_terms)
+{
+    CHECK(run("origin:net") == "23");
+    CHECK(run("sev>=WARN") == "124");
+    CHECK(run("sev<INFO") == "3");
+    CHECK(run("sev=CRIT") == "4");
+    CHECK(run("ts:[1700000001,1700000002]") == "12");
+    CHECK(run("ts:[1700000004,]") == "45");
+    CHECK(run("\"frame, done\"") == "5");
+    CHECK(run("/time(out|d out)/") == "23");
+    CHECK(run("origin:\"render, gpu\"") == "5");
+}
+//********************************************************************************************
+TEST(query_combinations)
+{
+    CHECK(run("origin:main render") == "04");
+    CHECK(run("!origin:main sev>=WARN") == "12");
+    CHECK(run("(timeout OR \"timed out\") AND NOT sev=FAIL") == "3");
+    CHECK(run("sev>=FAIL timeout, crash") == "24");
+    CHECK(run("origin:net AND (sev=DBUG OR /after/)") == "23");
+    CHECK(run("NOT (origin:main OR origin:net)") == "15");
+}
+//********************************************************************************************
+TEST(query_case_and_fuzzy)
+{
+    CHECK(run("origin:MAIN") == "");
+    CHECK(run("origin:MAIN", true) == "04");
+    CHECK(run("\"CRASH\" sev>=INFO", true) == "4");
+    CHECK(run("/CRASH/", true) == "4");
+    CHECK(run("\"timout\"", false, 1) == "2");
+    CHECK(run("\"timout\"", false, 0) == "");
+}
+//********************************************************************************************
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+ // EXTERNAL INCLUDES
+#include <string>
+// INTERNAL INCLUDES
+#include "log_store.h"
+#include "test.h"
+
+//********************************************************************************************
+TEST(store_byte_retention_releases_segments)
+{
+    const std::string content(100, 'x');
+    const u64 entry_bytes = content.size() + LOG_ENTRY_OVERHEAD;
+
+    log_store_t logs;
+    log_retention_t retention = {};
+    retention.max_bytes = entry_bytes * LOG_SEGMENT_CAPACITY * 5 / 2;
+    log_store_set_retention(logs, retention);
+
+    bool bounded = true;
+    for (u64 i = 0; i < LOG_SEGMENT_CAPACITY * 8; i++)
+    {
+        log_store_append(logs, i, INFO, "main", 4, content.data(), content.size());
+        if (logs.segments.size() > 1 && log_store_held_bytes(logs) > retention.max_bytes)
+            bounded = false;
+    }
+    CHECK(bounded);
+    CHECK(logs.dropped > 0);
+    CHECK(logs.segments.size() <= 4);
+    CHECK(logs.retained_bytes == log_store_size(logs) * entry_bytes);
+    CHECK(logs.retained_bytes <= retention.max_bytes);
+}
+//********************************************************************************************
+TEST(store_entries_larger_than_retention)
+{
+    // Every entry is evicted right away, the emptied segment must not linger at the front
+    const std::string content(1000, 'x');
+    log_store_t logs;
+    log_retention_t retention = {};
+    retention.max_bytes = 100;
+    retention.max_age = 10;
+    log_store_set_retention(logs, retention);
+
+    for (u64 i = 0; i < LOG_SEGMENT_CAPACITY * 2 + 10; i++)
+        log_store_append(logs, i * LOG_NS_PER_SECOND, INFO, "main", 4, content.data(), content.size());
+
+    CHECK(log_store_size(logs) == 0);
+    CHECK(logs.segments.size() == 1);
+    CHECK(logs.dropped == LOG_SEGMENT_CAPACITY * 2 + 10);
+}
+//********************************************************************************************
+TEST(store_long_origins_are_cut)
+{
+    const std::string origin(LOG_ORIGIN_MAX_LENGTH + 10, 'o');
+    log_store_t logs;
+    u16 id = log_store_intern_origin(logs, origin.data(), origin.size());
+    CHECK(log_store_origin(logs, id).size() == LOG_ORIGIN_MAX_LENGTH);
+    CHECK(log_store_intern_origin(logs, origin.data(), LOG_ORIGIN_MAX_LENGTH) == id);
+}
+//********************************************************************************************
+TEST(store_clear_forgets_origins)
+{
+    log_store_t logs;
+    log_store_append(logs, 1, INFO, "old", 3, "a", 1);
+    log_store_append(logs, 2, INFO, "older", 5, "b", 1);
+    log_store_clear(logs);
+    CHECK(logs.origin_names.empty());
+
+    log_store_append(logs, 3, INFO, "new", 3, "c", 1);
+    log_entry_ref_t entry;
+    CHECK(log_store_get(logs, logs.first_id, entry));
+    CHECK(entry.origin == 0);
+    CHECK(logs.origin_names.size() == 1);
+    CHECK(log_store_origin(logs, entry.origin) == "new");
+    CHECK(log_store_intern_origin(logs, "old", 3) == 1);
+}
+//********************************************************************************************
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+ // EXTERNAL INCLUDES
+#include <string.h>
+// INTERNAL INCLUDES
+#include "test.h"
+#include "time_format.h"
+
+//********************************************************************************************
+TEST(time_format_delta_units)
+{
+    char text[TIME_DELTA_SIZE];
+    time_format_delta(999, text);
+    CHECK(strcmp(text, "+999 ns") == 0);
+    time_format_delta(-1500, text);
+    CHECK(strcmp(text, "-1.500 us") == 0);
+    time_format_delta(2500000, text);
+    CHECK(strcmp(text, "+2.500 ms") == 0);
+    time_format_delta(3000000000ll, text);
+    CHECK(strcmp(text, "+3.000 s") == 0);
+}
+//********************************************************************************************
+TEST(time_format_row_delta_cached)
+{
+    static time_format_cache_t cache;
+    time_format_row(cache, 7, 1700000000000000000ull);
+    const char* text = time_format_row_delta(cache, 7, 1500);
+    CHECK(strcmp(text, "+1.500 us") == 0);
+    CHECK(time_format_row_delta(cache, 7, 1500) == text);
+
+    // Another row above it in the view
+    CHECK(strcmp(time_format_row_delta(cache, 7, 2000000), "+2.000 ms") == 0);
+
+    // A row that is not remembered is still formatted
+    CHECK(strcmp(time_format_row_delta(cache, 7 + TIME_CACHE_ROWS, 5), "+5 ns") == 0);
+    CHECK(strcmp(time_format_row_delta(cache, 7, 2000000), "+2.000 ms") == 0);
+}
+//********************************************************************************************
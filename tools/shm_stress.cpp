@@ -0,0 +1,104 @@
+/*
+ * Copyright 2025 Barracuda Bits
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this work and associated documentation files (the "Work"), to deal in the
+ * Work without restriction, including without limitation the rights to use, copy,
+ * modify, merge, publish, distribute, sublicense, and/or sell copies of the Work,
+ * and to permit persons to whom the Work is furnished to do so, subject to the
+ * following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Work.
+ *
+ * THE WORK IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+ * PARTICULAR PURPOSE, AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES, OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT, OR OTHERWISE, ARISING FROM, OUT OF, OR IN
+ * CONNECTION WITH THE WORK OR THE USE OR OTHER DEALINGS IN THE WORK.
+ */
+
+
+ // EXTERNAL INCLUDES
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+// INTERNAL INCLUDES
+#include "log_shm.h"
+
+//********************************************************************************************
+// Synthetic producer for the shared memory ring. Start bSpy first, it creates the ring.
+//
+//   shm_stress [seconds] [payload bytes] [--wait]
+//
+// Writes "timestamp,INFO,stress-N,payload" records as fast as the ring accepts them and
+// reports the rate. Without --wait records that do not fit are dropped, like a real
+// producer that must not block, with it the producer retries until the reader caught up.
+int main(int argc, char** argv)
+{
+    u32 seconds = 10;
+    u32 payload = 100;
+    bool wait = false;
+    u32 position = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--wait") == 0)
+            wait = true;
+        else if (position++ == 0)
+            seconds = (u32)atoi(argv[i]);
+        else
+            payload = (u32)atoi(argv[i]);
+    }
+    if (payload > 4096)
+        payload = 4096;
+
+    log_shm_t shm;
+    if (!log_shm_open(shm, LOG_SHM_DEFAULT_NAME))
+    {
+        fprintf(stderr, "Could not open %s, is bSpy running with the shared ring enabled?\n", LOG_SHM_DEFAULT_NAME);
+        return 1;
+    }
+
+    char content[4097];
+    memset(content, 'x', payload);
+    content[payload] = 0;
+
+    u64 written = 0;
+    u64 bytes = 0;
+    u64 dropped = 0;
+    char record[4096 + 128];
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + std::chrono::seconds(seconds);
+    while (std::chrono::steady_clock::now() < end)
+    {
+        // Check the clock only every few records, it is slower than writing one
+        for (u32 i = 0; i < 256; i++)
+        {
+            u64 now = (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            int length = snprintf(record, sizeof(record), "%llu,INFO,stress-%u,%s",
+                (unsigned long long)now, (u32)(written % 8), content);
+            while (!log_shm_write(shm, LOG_INGEST_RECORD, record, (size_t)length))
+            {
+                if (!wait)
+                {
+                    dropped++;
+                    break;
+                }
+                std::this_thread::yield();
+            }
+            written++;
+            bytes += (u64)length;
+        }
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("records:  %llu\n", (unsigned long long)written);
+    printf("dropped:  %llu\n", (unsigned long long)dropped);
+    printf("rate:     %.0f records/s, %.1f MB/s\n", written / elapsed, bytes / elapsed / (1024.0 * 1024.0));
+    log_shm_close(shm);
+    return 0;
+}